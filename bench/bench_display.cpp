@@ -0,0 +1,215 @@
+// 显示渲染与刷新基准测试
+// 用法: bench_display [--iterations N] [--filter 子串]
+// 每个用例输出一行JSON, 便于版本间对比回归
+#include "../include/ssd1315_display/ui_manager.hpp"
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <new>
+#include <string>
+
+namespace {
+std::atomic<uint64_t> g_allocations{0};
+}
+
+void *operator new(size_t size) {
+  g_allocations.fetch_add(1, std::memory_order_relaxed);
+  if (void *ptr = std::malloc(size ? size : 1))
+    return ptr;
+  throw std::bad_alloc();
+}
+void operator delete(void *ptr) noexcept { std::free(ptr); }
+void operator delete(void *ptr, size_t) noexcept { std::free(ptr); }
+
+namespace {
+
+/// @brief 单个用例的测量结果
+struct BenchResult {
+  std::string name;
+  uint64_t iterations;
+  double ns_per_op;
+  double allocs_per_op;
+  double bytes_per_op;
+  double syscalls_per_op;
+  double frames_sent_per_op;
+};
+
+struct BenchOptions {
+  uint64_t iterations = 2000;
+  const char *filter = nullptr;
+};
+
+void PrintResult(const BenchResult &r) {
+  std::printf("{\"bench\":\"%s\",\"iterations\":%llu,\"ns_per_op\":%.1f,"
+              "\"allocs_per_op\":%.2f,\"bytes_per_op\":%.1f,"
+              "\"syscalls_per_op\":%.2f,\"flushes_per_op\":%.2f}\n",
+              r.name.c_str(), static_cast<unsigned long long>(r.iterations),
+              r.ns_per_op, r.allocs_per_op, r.bytes_per_op, r.syscalls_per_op,
+              r.frames_sent_per_op);
+}
+
+/// @brief 运行一个用例: 先预热, 再计时并统计分配与传输量
+template <typename Setup, typename Op>
+void Run(const BenchOptions &options, const char *name,
+         SSD1315Display128x64 &display, Setup &&setup, Op &&op) {
+  if (options.filter && !std::strstr(name, options.filter))
+    return;
+
+  setup();
+  for (uint64_t i = 0; i < options.iterations / 10 + 1; i++)
+    op(i);
+
+  setup();
+  const DisplayFlushStats before = display.FlushStats();
+  const uint64_t allocs_before = g_allocations.load();
+  const auto start = std::chrono::steady_clock::now();
+  for (uint64_t i = 0; i < options.iterations; i++)
+    op(i);
+  const auto end = std::chrono::steady_clock::now();
+  const uint64_t allocs = g_allocations.load() - allocs_before;
+  const DisplayFlushStats after = display.FlushStats();
+
+  const double n = static_cast<double>(options.iterations);
+  BenchResult result;
+  result.name = name;
+  result.iterations = options.iterations;
+  result.ns_per_op =
+      std::chrono::duration<double, std::nano>(end - start).count() / n;
+  result.allocs_per_op = allocs / n;
+  result.bytes_per_op = (after.bytes_sent - before.bytes_sent) / n;
+  result.syscalls_per_op = (after.syscalls - before.syscalls) / n;
+  result.frames_sent_per_op =
+      ((after.frames - after.skipped_frames) -
+       (before.frames - before.skipped_frames)) /
+      n;
+  PrintResult(result);
+}
+
+template <typename Op>
+void Run(const BenchOptions &options, const char *name,
+         SSD1315Display128x64 &display, Op &&op) {
+  Run(options, name, display, [] {}, std::forward<Op>(op));
+}
+
+} // namespace
+
+int main(int argc, char const *argv[]) {
+  BenchOptions options;
+  for (int i = 1; i < argc; i++) {
+    if (!std::strcmp(argv[i], "--iterations") && i + 1 < argc)
+      options.iterations = std::strtoull(argv[++i], nullptr, 10);
+    else if (!std::strcmp(argv[i], "--filter") && i + 1 < argc)
+      options.filter = argv[++i];
+  }
+
+  SSD1315Display128x64 display(std::make_unique<MemoryTransport>(
+      SSD1315Display128x64::WIDTH, SSD1315Display128x64::HEIGHT));
+  UiManager ui_manager(display);
+
+  // 绘图原语(仅渲染, 不刷新)
+  Run(options, "primitive/DrawString", display, [&](uint64_t) {
+    display.DrawString(20, 22, "CPU: 45.2C", 1, 1);
+  });
+  Run(options, "primitive/DrawString_unaligned", display, [&](uint64_t) {
+    display.DrawString(20, 21, "CPU: 45.2C", 1, 1);
+  });
+  Run(options, "primitive/DrawString_size2", display, [&](uint64_t) {
+    display.DrawString(28, 10, "WELCOME", 1, 2);
+  });
+  Run(options, "primitive/FillCircle_r10", display,
+      [&](uint64_t) { display.FillCircle(64, 32, 10, 1); });
+  Run(options, "primitive/DrawRoundRect_full", display, [&](uint64_t) {
+    display.DrawRoundRect(0, 0, display.Width(), display.Height(), 3, 1);
+  });
+  Run(options, "primitive/FillRect_half", display,
+      [&](uint64_t) { display.FillRect(3, 5, 60, 50, 1); });
+  Run(options, "primitive/DrawProgressBar", display, [&](uint64_t i) {
+    display.DrawProgressBar(8, 30, 112, 6, i % 101, 1);
+  });
+  Run(options, "primitive/ScrollRectLeft_graph", display, [&](uint64_t) {
+    display.ScrollRectLeft(2, 12, 124, 20, 1);
+  });
+  Run(options, "primitive/ClearDisplay", display,
+      [&](uint64_t) { display.ClearDisplay(); });
+
+  // 刷新: 整屏、单像素变化、无变化
+  Run(options, "flush/full", display, [&](uint64_t) {
+    display.InvalidateDisplay();
+    display.RefreshDisplay();
+  });
+  Run(options, "flush/one_pixel", display, [&](uint64_t i) {
+    display.DrawPixel(i % 128, 32, 2);
+    display.RefreshDisplay();
+  });
+  Run(options, "flush/unchanged", display,
+      [&](uint64_t) { display.RefreshDisplay(); });
+
+  // UiManager页面: 数据不变与数据变化两种稳态
+  DevTempInfo temp{45.2, 41.0, 43.5, 40.1};
+  MemInfo mem{3900, 1200, 30.7};
+  DiskInfo disk{};
+  std::vector<NetInfo> net_infos = {{"lo", "127.0.0.1", "IPv4"},
+                                    {"eth0", "192.168.1.20", "IPv4"},
+                                    {"wlan0", "10.0.0.7", "IPv4"}};
+  std::vector<NetTraffic> traffic(2);
+  traffic[0].interface_name = "lo";
+  traffic[1].interface_name = "eth0";
+  SystemTime sys_time{12, 30, 0, 16, 10, 2026};
+  CpuFreqInfo freq{1416, 480, 1800};
+  SystemLoad load{0.42, 0.35, 0.30};
+  const std::string uptime = "3d 4h 5m";
+  auto enter_page = [&] { ui_manager.Invalidate(); };
+
+  Run(options, "page/DevTemp_static", display, enter_page,
+      [&](uint64_t) { ui_manager.DrawDevTempPage(temp); });
+  Run(options, "page/DevTemp_changing", display, enter_page, [&](uint64_t i) {
+    temp.cpu_t = 40.0 + (i % 50) * 0.3;
+    ui_manager.DrawDevTempPage(temp);
+  });
+  Run(options, "page/Usage_changing", display, enter_page, [&](uint64_t i) {
+    ui_manager.DrawDevMemAndDiskAndCpuUsagePage(i % 100, mem, disk);
+  });
+  Run(options, "page/NetInfos_animated", display, enter_page,
+      [&](uint64_t) { ui_manager.DrawNetInfosPage(net_infos); });
+  Run(options, "page/NetTraffic_changing", display, enter_page,
+      [&](uint64_t i) {
+        traffic[1].rx_mbps = (i % 40) * 0.1;
+        traffic[1].tx_mbps = (i % 17) * 0.1;
+        ui_manager.DrawNetTrafficPage(traffic);
+      });
+  Run(options, "page/SystemTime_changing", display, enter_page,
+      [&](uint64_t i) {
+        sys_time.second = i % 60;
+        ui_manager.DrawSystemTimePage(sys_time);
+      });
+  Run(options, "page/SystemInfo_static", display, enter_page,
+      [&](uint64_t) { ui_manager.DrawSystemInfoPage(freq, load, uptime); });
+  // 趋势页: 每帧追加一个样本, 图表滚动一列
+  MetricHistory history(256);
+  auto push_sample = [&](uint64_t i) {
+    MetricSample sample;
+    sample.time_ms = static_cast<int64_t>(i) * 1000;
+    sample.cpu_usage = static_cast<float>((i * 37) % 100);
+    sample.cpu_temp = static_cast<float>(40 + (i % 30));
+    sample.rx_mbps = static_cast<float>((i % 40) * 0.1);
+    sample.tx_mbps = static_cast<float>((i % 17) * 0.1);
+    history.Append(sample);
+  };
+  Run(options, "page/CpuTempHistory_scrolling", display, enter_page,
+      [&](uint64_t i) {
+        push_sample(i);
+        ui_manager.DrawCpuTempHistoryPage(history);
+      });
+  Run(options, "page/NetHistory_scrolling", display, enter_page,
+      [&](uint64_t i) {
+        push_sample(i);
+        ui_manager.DrawNetHistoryPage(history);
+      });
+  Run(options, "page/rebuild_each_frame", display, [&](uint64_t) {
+    ui_manager.Invalidate();
+    ui_manager.DrawDevTempPage(temp);
+  });
+  return 0;
+}
@@ -0,0 +1,114 @@
+// 历史文件写入与扫描基准测试
+// 用法: bench_history [--samples N] [--path 文件]
+// 每个用例输出一行JSON, 便于版本间对比回归
+#include "../include/system_monitor/history_store.hpp"
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <unistd.h>
+
+namespace {
+
+struct BenchOptions {
+  uint64_t samples = 1000000;
+  std::string path = "/tmp/bench_history.hist";
+};
+
+/// @brief 生成接近真实负载的采样序列(1秒间隔, 带少量抖动)
+MetricSample MakeSample(uint64_t i) {
+  MetricSample s;
+  s.time_ms = 1700000000000LL + static_cast<int64_t>(i) * 1000 +
+              static_cast<int64_t>(i * 7919 % 5);
+  s.cpu_usage = static_cast<float>(20 + 15 * std::sin(i * 0.01) + (i % 7));
+  s.mem_usage = static_cast<float>(35.0 + (i / 600) % 5 * 0.1);
+  s.disk_usage = 68.3f;
+  s.cpu_temp = static_cast<float>(45 + (i % 20) * 0.1);
+  s.gpu_temp = static_cast<float>(42 + (i % 30) * 0.1);
+  s.rx_mbps = static_cast<float>((i % 13) * 0.25);
+  s.tx_mbps = static_cast<float>((i % 5) * 0.1);
+  s.load1 = static_cast<float>(0.3 + (i % 50) * 0.01);
+  return s;
+}
+
+void PrintResult(const char *name, uint64_t samples, double seconds,
+                 uint64_t bytes) {
+  std::printf("{\"bench\":\"%s\",\"samples\":%llu,\"samples_per_sec\":%.0f,"
+              "\"ns_per_sample\":%.1f,\"bytes_per_sample\":%.2f}\n",
+              name, static_cast<unsigned long long>(samples),
+              samples / seconds, seconds * 1e9 / samples,
+              static_cast<double>(bytes) / samples);
+}
+
+} // namespace
+
+int main(int argc, char const *argv[]) {
+  BenchOptions options;
+  for (int i = 1; i < argc; i++) {
+    if (!std::strcmp(argv[i], "--samples") && i + 1 < argc)
+      options.samples = std::strtoull(argv[++i], nullptr, 10);
+    else if (!std::strcmp(argv[i], "--path") && i + 1 < argc)
+      options.path = argv[++i];
+  }
+  unlink(options.path.c_str());
+  unlink((options.path + ".idx").c_str());
+
+  // 写入: 编码 + 批量落盘
+  uint64_t file_size = 0;
+  {
+    HistoryStoreWriter writer;
+    if (!writer.Open(options.path))
+      return 1;
+    const auto start = std::chrono::steady_clock::now();
+    for (uint64_t i = 0; i < options.samples; i++)
+      writer.Append(MakeSample(i));
+    writer.Flush();
+    const auto end = std::chrono::steady_clock::now();
+    file_size = writer.FileSize();
+    PrintResult("history/ingest", options.samples,
+                std::chrono::duration<double>(end - start).count(), file_size);
+  }
+
+  // 扫描: mmap + 全量解码
+  HistoryStoreReader reader;
+  if (!reader.Open(options.path))
+    return 1;
+  std::vector<MetricSample> samples;
+  samples.reserve(options.samples);
+  auto start = std::chrono::steady_clock::now();
+  reader.Query(INT64_MIN, INT64_MAX, samples);
+  auto end = std::chrono::steady_clock::now();
+  PrintResult("history/scan_full", samples.size(),
+              std::chrono::duration<double>(end - start).count(), file_size);
+
+  // 校验解码结果
+  if (samples.size() != options.samples) {
+    std::fprintf(stderr, "解码样本数不一致: %zu, 应为%llu\n", samples.size(),
+                 static_cast<unsigned long long>(options.samples));
+    return 1;
+  }
+  for (uint64_t i = 0; i < samples.size(); i++) {
+    const MetricSample expected = MakeSample(i);
+    if (std::memcmp(&expected, &samples[i], sizeof(MetricSample)) != 0) {
+      std::fprintf(stderr, "第%llu个样本解码不一致\n",
+                   static_cast<unsigned long long>(i));
+      return 1;
+    }
+  }
+
+  // 区间查询: 最近1小时
+  samples.clear();
+  const int64_t last = MakeSample(options.samples - 1).time_ms;
+  start = std::chrono::steady_clock::now();
+  const int iterations = 1000;
+  for (int i = 0; i < iterations; i++) {
+    samples.clear();
+    reader.Query(last - 3600 * 1000, last, samples);
+  }
+  end = std::chrono::steady_clock::now();
+  PrintResult("history/query_last_hour", samples.size() * iterations,
+              std::chrono::duration<double>(end - start).count(), 0);
+  return 0;
+}
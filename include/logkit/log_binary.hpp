@@ -0,0 +1,284 @@
+#pragma once
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <string>
+#include <string_view>
+#include <type_traits>
+
+/// @brief 二进制日志格式
+/// @note 文件以FILE_MAGIC开头, 之后为连续的记录, 每条记录以1字节类型开头:
+///       FORMAT: id(u32) level(u8) line(u32) func_len(u16) func fmt_len(u16) fmt
+///       RECORD: id(u32) time_ns(i64) args_len(u16) args
+///       文本级别的日志不进入二进制文件, 仍写入.log
+///       同一格式ID在每个文件中只写一次FORMAT记录, 且位于其第一条RECORD之前。
+///       参数为带1字节类型标签的原始字节, 整数标签区分宽度(不足int的按int提升),
+///       字符串按u16长度加内容存放
+namespace logbin {
+
+constexpr char FILE_MAGIC[8] = {'L', 'O', 'G', 'K', 'B', 'I', 'N', '2'};
+
+enum RecordType : uint8_t {
+  FORMAT = 'F',
+  RECORD = 'R',
+};
+
+enum ArgTag : uint8_t {
+  INT32 = 'i',   // int32
+  INT64 = 'I',   // int64
+  UINT32 = 'u',  // uint32
+  UINT64 = 'U',  // uint64
+  DOUBLE = 'd',  // double
+  STRING = 's',  // u16长度 + 内容
+  POINTER = 'p', // uint64
+};
+
+/// @brief 把printf参数按类型标签编码到固定缓冲区
+/// @note 空间不足时字符串截断, 其他参数连同其后的参数全部丢弃(解码时显示为
+///       截断标记); Size()只包含实际写入的字节, 不含队列槽位中的旧数据
+class ArgEncoder {
+private:
+  char *begin_;
+  char *pos_;
+  char *end_;
+  bool truncated_ = false; // 已有参数被丢弃, 后续参数不再写入以免错位
+
+  template <typename T> void Put(ArgTag tag, T value) {
+    if (truncated_ || end_ - pos_ < static_cast<ptrdiff_t>(1 + sizeof(T))) {
+      truncated_ = true;
+      return;
+    }
+    *pos_++ = static_cast<char>(tag);
+    std::memcpy(pos_, &value, sizeof(T));
+    pos_ += sizeof(T);
+  }
+
+  // 按printf默认实参提升记录整数, 保留其宽度供%u/%x等转换截断
+  template <typename T> void PutInteger(T value) {
+    if constexpr (sizeof(T) < sizeof(int32_t))
+      Put(INT32, static_cast<int32_t>(value));
+    else if constexpr (sizeof(T) == sizeof(int32_t))
+      Put(std::is_signed_v<T> ? INT32 : UINT32, value);
+    else
+      Put(std::is_signed_v<T> ? INT64 : UINT64, value);
+  }
+
+public:
+  ArgEncoder(char *buffer, size_t capacity)
+      : begin_(buffer), pos_(buffer), end_(buffer + capacity) {}
+
+  void Append(const char *text) {
+    if (!text)
+      text = "(null)";
+    const size_t room = end_ - pos_;
+    if (truncated_ || room < 3) {
+      truncated_ = true;
+      return;
+    }
+    const uint16_t length = static_cast<uint16_t>(
+        std::min<size_t>(std::strlen(text), std::min<size_t>(room - 3, 0xFFFF)));
+    *pos_++ = static_cast<char>(STRING);
+    std::memcpy(pos_, &length, sizeof(length));
+    std::memcpy(pos_ + sizeof(length), text, length);
+    pos_ += sizeof(length) + length;
+  }
+  void Append(char *text) { Append(static_cast<const char *>(text)); }
+
+  template <typename T> void Append(T value) {
+    if constexpr (std::is_floating_point_v<T>)
+      Put(DOUBLE, static_cast<double>(value));
+    else if constexpr (std::is_pointer_v<T>)
+      Put(POINTER, static_cast<uint64_t>(reinterpret_cast<uintptr_t>(value)));
+    else if constexpr (std::is_enum_v<T>)
+      PutInteger(static_cast<std::underlying_type_t<T>>(value));
+    else
+      PutInteger(value);
+  }
+
+  size_t Size() const { return pos_ - begin_; }
+  bool Truncated() const { return truncated_; }
+};
+
+/// @brief 按格式串渲染编码后的参数(离线解码使用)
+/// @param format printf格式串
+/// @param args 参数字节
+/// @param size 参数字节数
+/// @param out 输出文本
+inline void RenderFormat(const char *format, const char *args, size_t size,
+                         std::string &out) {
+  static constexpr const char *TRUNCATED_MARK = "<trunc>";
+  const char *pos = args;
+  const char *end = args + size;
+  char buffer[512];
+
+  // 取出下一个参数, 编码时被丢弃的参数标记为missing(数值视为0)
+  struct Arg {
+    uint8_t tag = INT32;
+    size_t width = 4; // 整数宽度(字节)
+    uint64_t bits = 0;
+    double real = 0;
+    std::string_view text;
+    bool missing = true;
+  };
+  auto next = [&]() {
+    Arg arg;
+    if (pos >= end)
+      return arg;
+    arg.missing = false;
+    arg.tag = static_cast<uint8_t>(*pos++);
+    if (arg.tag == STRING) {
+      uint16_t length = 0;
+      if (end - pos >= 2) {
+        std::memcpy(&length, pos, sizeof(length));
+        pos += 2;
+      }
+      length = static_cast<uint16_t>(std::min<ptrdiff_t>(length, end - pos));
+      arg.text = std::string_view(pos, length);
+      pos += length;
+    } else {
+      arg.width = (arg.tag == INT32 || arg.tag == UINT32) ? 4 : 8;
+      if (end - pos < static_cast<ptrdiff_t>(arg.width)) {
+        pos = end;
+        arg.missing = true;
+        return arg;
+      }
+      std::memcpy(&arg.bits, pos, arg.width);
+      if (arg.width == 8)
+        std::memcpy(&arg.real, pos, 8);
+      pos += arg.width;
+    }
+    return arg;
+  };
+  // 截断到width字节后按无符号/有符号解释, 与printf对同宽度实参的行为一致
+  auto as_unsigned = [](const Arg &arg, size_t width) -> uint64_t {
+    const uint64_t bits =
+        arg.tag == DOUBLE
+            ? static_cast<uint64_t>(static_cast<int64_t>(arg.real))
+            : arg.bits;
+    return width >= 8 ? bits : bits & ((1ULL << (width * 8)) - 1);
+  };
+  auto as_signed = [&](const Arg &arg, size_t width) -> int64_t {
+    const uint64_t bits = as_unsigned(arg, width);
+    if (width >= 8)
+      return static_cast<int64_t>(bits);
+    const uint64_t sign = 1ULL << (width * 8 - 1);
+    return static_cast<int64_t>((bits ^ sign) - sign);
+  };
+  auto as_int = [&](const Arg &arg) { return as_signed(arg, arg.width); };
+  // 按转换说明输出一个值, 超出栈缓冲区时按snprintf返回的长度直接写入out
+  auto emit = [&](const std::string &spec, auto value) {
+    const int n = std::snprintf(buffer, sizeof(buffer), spec.c_str(), value);
+    if (n <= 0)
+      return;
+    if (static_cast<size_t>(n) < sizeof(buffer)) {
+      out.append(buffer, n);
+      return;
+    }
+    const size_t offset = out.size();
+    out.resize(offset + n + 1);
+    std::snprintf(&out[offset], n + 1, spec.c_str(), value);
+    out.resize(offset + n);
+  };
+
+  for (const char *p = format; *p; p++) {
+    if (*p != '%') {
+      out.push_back(*p);
+      continue;
+    }
+    if (p[1] == '%') {
+      out.push_back('%');
+      p++;
+      continue;
+    }
+
+    // 重建转换说明: 保留标志/宽度/精度, 长度修饰按参数类型重写
+    std::string spec = "%";
+    p++;
+    while (*p && std::strchr("-+ #0", *p))
+      spec.push_back(*p++);
+    if (*p == '*') {
+      spec += std::to_string(as_int(next()));
+      p++;
+    }
+    while (*p >= '0' && *p <= '9')
+      spec.push_back(*p++);
+    if (*p == '.') {
+      spec.push_back(*p++);
+      if (*p == '*') {
+        spec += std::to_string(as_int(next()));
+        p++;
+      }
+      while (*p >= '0' && *p <= '9')
+        spec.push_back(*p++);
+    }
+    // h/hh把实参再截断到short/char, 其余长度修饰由参数宽度决定
+    size_t modifier_width = 8;
+    while (*p && std::strchr("hlLqjzt", *p)) {
+      if (*p == 'h')
+        modifier_width = modifier_width == 2 ? 1 : 2;
+      p++;
+    }
+    if (!*p)
+      break;
+
+    const char conversion = *p;
+    const Arg arg = next();
+    if (arg.missing) {
+      out += TRUNCATED_MARK;
+      continue;
+    }
+    const size_t width = std::min(arg.width, modifier_width);
+    switch (conversion) {
+    case 'd':
+    case 'i':
+      spec += "lld";
+      emit(spec, static_cast<long long>(as_signed(arg, width)));
+      break;
+    case 'u':
+    case 'x':
+    case 'X':
+    case 'o':
+      spec += "ll";
+      spec.push_back(conversion);
+      emit(spec, static_cast<unsigned long long>(as_unsigned(arg, width)));
+      break;
+    case 'c':
+      spec.push_back('c');
+      emit(spec, static_cast<int>(as_int(arg)));
+      break;
+    case 'f':
+    case 'F':
+    case 'e':
+    case 'E':
+    case 'g':
+    case 'G':
+    case 'a':
+    case 'A':
+      spec.push_back(conversion);
+      emit(spec, arg.tag == DOUBLE ? arg.real
+                                   : static_cast<double>(as_int(arg)));
+      break;
+    case 's': {
+      if (spec.size() == 1) { // 无宽度/精度时直接追加
+        out.append(arg.text);
+        break;
+      }
+      const std::string text(arg.text);
+      spec.push_back('s');
+      emit(spec, text.c_str());
+      break;
+    }
+    case 'p':
+      emit(std::string("0x%llx"), static_cast<unsigned long long>(arg.bits));
+      break;
+    default:
+      spec.push_back(conversion);
+      out += spec;
+      break;
+    }
+  }
+}
+
+} // namespace logbin
@@ -0,0 +1,125 @@
+#pragma once
+#include <algorithm>
+#include <charconv>
+#include <cstdint>
+#include <cstring>
+#include <ctime>
+#include <sstream>
+#include <string>
+#include <string_view>
+#include <type_traits>
+
+/// @brief 向固定缓冲区追加文本, 不使用iostream、不分配内存, 超出容量时截断
+class LineWriter {
+private:
+  char *begin_;
+  char *pos_;
+  char *end_;
+
+public:
+  LineWriter(char *buffer, size_t capacity)
+      : begin_(buffer), pos_(buffer), end_(buffer + capacity) {}
+
+  void Append(const char *data, size_t size) {
+    size = std::min<size_t>(size, end_ - pos_);
+    std::memcpy(pos_, data, size);
+    pos_ += size;
+  }
+
+  void Append(std::string_view text) { Append(text.data(), text.size()); }
+  void Append(const std::string &text) { Append(text.data(), text.size()); }
+  void Append(const char *text) { Append(std::string_view(text)); }
+  void Append(char *text) { Append(std::string_view(text)); }
+
+  void Append(char c) {
+    if (pos_ < end_)
+      *pos_++ = c;
+  }
+
+  /// @brief 与ostream默认行为一致, signed char/unsigned char(含int8_t/uint8_t)
+  ///        按字符输出
+  void Append(signed char c) { Append(static_cast<char>(c)); }
+  void Append(unsigned char c) { Append(static_cast<char>(c)); }
+
+  /// @brief 与ostream默认行为一致, bool输出为1/0
+  void Append(bool value) { Append(value ? '1' : '0'); }
+
+  /// @brief 整数用to_chars格式化
+  template <typename T>
+  std::enable_if_t<std::is_integral_v<T> && !std::is_same_v<T, bool> &&
+                   !std::is_same_v<T, char> && !std::is_same_v<T, signed char> &&
+                   !std::is_same_v<T, unsigned char>>
+  Append(T value) {
+    auto result = std::to_chars(pos_, end_, value);
+    if (result.ec == std::errc())
+      pos_ = result.ptr;
+  }
+
+  /// @brief 浮点数按6位有效数字输出, 与ostream默认格式一致
+  template <typename T>
+  std::enable_if_t<std::is_floating_point_v<T>> Append(T value) {
+    auto result = std::to_chars(pos_, end_, value, std::chars_format::general, 6);
+    if (result.ec == std::errc())
+      pos_ = result.ptr;
+  }
+
+  /// @brief 其他类型退回ostringstream(会分配内存, 仅用于不常见的类型)
+  template <typename T>
+  std::enable_if_t<!std::is_arithmetic_v<std::decay_t<T>> &&
+                   !std::is_convertible_v<const T &, std::string_view>>
+  Append(const T &value) {
+    std::ostringstream oss;
+    oss << value;
+    Append(oss.str());
+  }
+
+  /// @brief 追加无符号整数, 不足width位时左侧补0
+  void AppendPadded(uint32_t value, int width) {
+    char digits[10];
+    auto result = std::to_chars(digits, digits + sizeof(digits), value);
+    for (int i = static_cast<int>(result.ptr - digits); i < width; i++)
+      Append('0');
+    Append(digits, result.ptr - digits);
+  }
+
+  size_t Size() const { return pos_ - begin_; }
+  bool Full() const { return pos_ == end_; }
+};
+
+/// @brief 每秒格式化一次的时间前缀缓存
+/// @note 同一秒内的日志直接复用上次的文本, 跨秒时才调用localtime_r
+class TimestampCache {
+private:
+  int64_t second_ = INT64_MIN;
+  char text_[20] = {}; // "YYYY-MM-DD HH:MM:SS"
+
+public:
+  /// @brief 获取时间文本(19个字符, 前10个为日期)
+  std::string_view Format(int64_t time_ns) {
+    int64_t second = time_ns / 1000000000;
+    if (time_ns < 0 && second * 1000000000 != time_ns)
+      second--;
+    if (second != second_) {
+      second_ = second;
+      time_t time = static_cast<time_t>(second);
+      std::tm tm;
+      localtime_r(&time, &tm);
+      LineWriter writer(text_, sizeof(text_));
+      writer.AppendPadded(tm.tm_year + 1900, 4);
+      writer.Append('-');
+      writer.AppendPadded(tm.tm_mon + 1, 2);
+      writer.Append('-');
+      writer.AppendPadded(tm.tm_mday, 2);
+      writer.Append(' ');
+      writer.AppendPadded(tm.tm_hour, 2);
+      writer.Append(':');
+      writer.AppendPadded(tm.tm_min, 2);
+      writer.Append(':');
+      writer.AppendPadded(tm.tm_sec, 2);
+    }
+    return std::string_view(text_, 19);
+  }
+
+  /// @brief 获取日期文本("YYYY-MM-DD")
+  std::string_view Date(int64_t time_ns) { return Format(time_ns).substr(0, 10); }
+};
@@ -0,0 +1,117 @@
+#pragma once
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+
+/// @brief 有界无锁队列(Vyukov算法), 多生产者写入, 由后台线程消费
+/// @note 每个槽位带序列号: 等于位置表示可写, 等于位置+1表示可读。
+///       出队同样使用CAS, 因此生产者在队列满时也可以丢弃最旧的一条。
+///       元素在槽位内原地构造/读取, 入队与出队均不分配内存
+template <typename T> class LogQueue {
+private:
+  struct Cell {
+    std::atomic<size_t> sequence;
+    T data;
+  };
+
+  static constexpr size_t CACHE_LINE = 64;
+
+  std::unique_ptr<Cell[]> cells_;
+  const size_t mask_;
+  alignas(CACHE_LINE) std::atomic<size_t> enqueue_pos_{0};
+  alignas(CACHE_LINE) std::atomic<size_t> dequeue_pos_{0};
+
+  static size_t RoundUpPow2(size_t value) {
+    size_t size = 2;
+    while (size < value)
+      size <<= 1;
+    return size;
+  }
+
+public:
+  /// @param capacity 槽位数, 向上取整为2的幂
+  explicit LogQueue(size_t capacity)
+      : cells_(new Cell[RoundUpPow2(capacity)]),
+        mask_(RoundUpPow2(capacity) - 1) {
+    for (size_t i = 0; i <= mask_; i++)
+      cells_[i].sequence.store(i, std::memory_order_relaxed);
+  }
+
+  LogQueue(const LogQueue &) = delete;
+  LogQueue &operator=(const LogQueue &) = delete;
+
+  /// @brief 预留一个可写槽位
+  /// @return 队列满时返回nullptr; 成功时须调用Commit()发布
+  T *TryClaim(size_t &pos) {
+    pos = enqueue_pos_.load(std::memory_order_relaxed);
+    while (true) {
+      Cell &cell = cells_[pos & mask_];
+      const size_t seq = cell.sequence.load(std::memory_order_acquire);
+      const intptr_t diff =
+          static_cast<intptr_t>(seq) - static_cast<intptr_t>(pos);
+      if (diff == 0) {
+        if (enqueue_pos_.compare_exchange_weak(pos, pos + 1,
+                                               std::memory_order_relaxed))
+          return &cell.data;
+      } else if (diff < 0) {
+        return nullptr;
+      } else {
+        pos = enqueue_pos_.load(std::memory_order_relaxed);
+      }
+    }
+  }
+
+  /// @brief 发布TryClaim()预留的槽位
+  void Commit(size_t pos) {
+    cells_[pos & mask_].sequence.store(pos + 1, std::memory_order_release);
+  }
+
+  /// @brief 取出最旧的一条, 用func读取槽位内容
+  /// @return 队列为空时返回false
+  template <typename Func> bool TryConsume(Func &&func) {
+    size_t pos = dequeue_pos_.load(std::memory_order_relaxed);
+    while (true) {
+      Cell &cell = cells_[pos & mask_];
+      const size_t seq = cell.sequence.load(std::memory_order_acquire);
+      const intptr_t diff =
+          static_cast<intptr_t>(seq) - static_cast<intptr_t>(pos + 1);
+      if (diff == 0) {
+        if (dequeue_pos_.compare_exchange_weak(pos, pos + 1,
+                                               std::memory_order_relaxed)) {
+          func(cell.data);
+          cell.sequence.store(pos + mask_ + 1, std::memory_order_release);
+          return true;
+        }
+      } else if (diff < 0) {
+        return false;
+      } else {
+        pos = dequeue_pos_.load(std::memory_order_relaxed);
+      }
+    }
+  }
+
+  /// @brief 丢弃最旧的一条(队列满且策略为丢弃最旧时由生产者调用)
+  bool DropOldest() {
+    return TryConsume([](T &) {});
+  }
+
+  /// @brief 最旧的一条是否已发布(可取出)
+  bool Readable() const {
+    const size_t pos = dequeue_pos_.load(std::memory_order_acquire);
+    return cells_[pos & mask_].sequence.load(std::memory_order_acquire) ==
+           pos + 1;
+  }
+
+  /// @brief 已预留的位置总数(单调递增)
+  size_t EnqueuePos() const {
+    return enqueue_pos_.load(std::memory_order_acquire);
+  }
+
+  /// @brief 已取出的位置总数(单调递增)
+  size_t DequeuePos() const {
+    return dequeue_pos_.load(std::memory_order_acquire);
+  }
+
+  size_t Capacity() const { return mask_ + 1; }
+};
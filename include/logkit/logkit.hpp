@@ -1,11 +1,17 @@
 #pragma once
 #include "./ini_reader.hpp"
+#include "./log_binary.hpp"
+#include "./log_format.hpp"
+#include "./log_queue.hpp"
 
 #include <atomic>
+#include <cerrno>
 #include <chrono>
+#include <condition_variable>
 #include <cstdarg>
+#include <cstring>
 #include <ctime>
-#include <fstream>
+#include <fcntl.h>
 #include <iomanip>
 #include <iostream>
 #include <memory>
@@ -13,16 +19,90 @@
 #include <sstream>
 #include <sys/stat.h>
 #include <thread>
+#include <unistd.h>
 #include <vector>
 
+/// @brief 编译期最低日志级别(由CMake的LOGKIT_MIN_LEVEL设置)
+/// @note 低于该级别的LOG_*/LOGP_*宏展开为空, 参数不会被求值; MSG与INFO同级
+#define LOGKIT_LEVEL_DEBUG 0
+#define LOGKIT_LEVEL_INFO 1
+#define LOGKIT_LEVEL_WARN 2
+#define LOGKIT_LEVEL_ERROR 3
+#ifndef LOGKIT_MIN_LEVEL
+#define LOGKIT_MIN_LEVEL LOGKIT_LEVEL_DEBUG
+#endif
+
 class LogKit {
 public:
   enum LogLevel { MSG, INFO, WARN, DEBUG, ERROR };
 
+  /// @brief 异步模式下队列满时的处理策略
+  enum OverflowPolicy {
+    BLOCK,       // 调用方等待写线程腾出空间
+    DROP_OLDEST, // 丢弃最旧的一条
+    DROP_NEW,    // 丢弃当前这条
+  };
+
+  /// @brief 异步日志统计
+  struct Stats {
+    uint64_t enqueued{0}; // 入队条数
+    uint64_t dropped{0};  // 因队列满丢弃的条数
+    uint64_t blocked{0};  // 调用方因队列满等待的次数
+    uint64_t batches{0};  // 写线程批量写入的次数
+  };
+
+  /// @brief 日志文件写出的触发原因
+  enum FlushReason {
+    FLUSH_INTERVAL, // 距上次写出超过interval_ms
+    FLUSH_BYTES,    // 缓冲数据达到buffer_kb
+    FLUSH_LEVEL,    // WARN/ERROR立即写出
+    FLUSH_OTHER,    // 文件轮转、Flush()与退出
+    FLUSH_REASONS,
+  };
+
+  /// @brief 日志文件写出统计
+  struct FlushStats {
+    uint64_t lines{0};                // 写入文件缓冲的条数
+    uint64_t writes[FLUSH_REASONS]{}; // 各原因触发的write系统调用次数
+    uint64_t bytes[FLUSH_REASONS]{};  // 各原因写出的字节数
+    uint64_t syncs{0};                // fdatasync次数
+  };
+
+  /// @brief LOGP_*调用点的静态描述(函数内静态对象), 首次执行时注册格式ID
+  /// @note format/func须为静态存储的字符串, 二进制模式下写线程按ID引用
+  struct FormatSite {
+    LogLevel level;
+    const char *func;
+    uint32_t line;
+    const char *format;
+    uint32_t id;
+
+    FormatSite(LogLevel level, const char *func, uint32_t line,
+               const char *format)
+        : level(level), func(func), line(line), format(format),
+          id(RegisterSite(this)) {}
+  };
+
 private:
   static constexpr const char *CONFIG_PATH = "./configs/log_config.ini";
   static constexpr const char *GLOBAL_SECTION = "LOG_GLOBAL";
   static constexpr const char *LEVEL_SECTION = "LOG_LEVEL";
+  static constexpr const char *ASYNC_SECTION = "LOG_ASYNC";
+  static constexpr const char *BINARY_SECTION = "LOG_BINARY";
+  static constexpr const char *FLUSH_SECTION = "LOG_FLUSH";
+  static constexpr size_t TEXT_CAPACITY = 1024; // 单条日志正文上限(字节)
+  static constexpr size_t BATCH_ENTRIES = 64;   // 写线程每批最多处理的条数
+
+  /// @brief 一条待写入的日志, 调用方在队列槽位内原地填写
+  struct Entry {
+    int64_t time_ns;  // 记录时间(system_clock)
+    LogLevel level;
+    const char *func; // __func__, 静态存储
+    uint32_t line;
+    uint32_t format_id; // 非0时text为二进制参数, 0时为格式化后的正文
+    uint32_t length;    // text有效长度
+    char text[TEXT_CAPACITY];
+  };
 
   struct Config {
     size_t max_file_size = 1024 * 1024; // 1MB
@@ -35,21 +115,92 @@ private:
     bool level_warn = false;
     bool level_debug = false;
     bool level_error = false;
+    bool async = false;          // 异步写入(启动时生效)
+    size_t queue_size = 1024;    // 异步队列槽位数(启动时生效)
+    std::string overflow = "block";
+    bool binary_msg = false;     // 以下级别的LOGP_*按二进制记录
+    bool binary_info = false;
+    bool binary_warn = false;
+    bool binary_debug = false;
+    bool binary_error = false;
+    size_t flush_interval_ms = 0;     // 缓冲数据最长保留时间, 0为每批写出
+    size_t buffer_size = 64 * 1024;   // 缓冲达到该字节数时写出
+    bool flush_warn = true;           // WARN立即写出
+    bool flush_error = true;          // ERROR立即写出
+    size_t sync_interval_ms = 0;      // fdatasync间隔, 0为不调用
   };
 
   struct FileManager {
-    std::ofstream file;
+    int fd = -1;
+    std::string pending;          // 尚未写出的数据
     std::string current_date;
     size_t current_index = 0;
+    size_t size = 0;              // 文件大小(字节, 含pending)
+    const char *extension = ".log";
+    std::vector<bool> emitted;    // 二进制文件: 已写出定义的格式ID
+
+    bool IsOpen() const { return fd >= 0; }
+  };
+
+  /// @brief 格式ID注册表, ID为下标+1
+  struct SiteRegistry {
+    std::mutex mutex;
+    std::vector<const FormatSite *> sites;
   };
 
+  static SiteRegistry &Sites() {
+    static SiteRegistry registry;
+    return registry;
+  }
+
+  static uint32_t RegisterSite(const FormatSite *site) {
+    SiteRegistry &registry = Sites();
+    std::lock_guard<std::mutex> lock(registry.mutex);
+    registry.sites.push_back(site);
+    return static_cast<uint32_t>(registry.sites.size());
+  }
+
+  static const FormatSite *FindSite(uint32_t id) {
+    SiteRegistry &registry = Sites();
+    std::lock_guard<std::mutex> lock(registry.mutex);
+    return id > 0 && id <= registry.sites.size() ? registry.sites[id - 1]
+                                                 : nullptr;
+  }
+
+  /// @brief 运行时启用的级别(1 << level), 宏在求值参数前检查
+  /// @note 初始为全部启用, 以便首次调用时构造实例并加载配置
+  inline static std::atomic<uint32_t> level_mask_{~0u};
+
   std::mutex mutex_;
   FileManager file_manager_;
+  FileManager binary_file_; // 二进制日志(.blog), 由logkit-decode解码
   Config config_;
   std::atomic<bool> running_{true};
   std::unique_ptr<std::thread> config_monitor_;
   std::unique_ptr<IniReader> ini_reader_;
 
+  // 异步模式: 调用方写入队列后立即返回, 写线程批量写文件与终端
+  std::unique_ptr<LogQueue<Entry>> queue_;
+  std::unique_ptr<std::thread> writer_;
+  std::atomic<int> overflow_{BLOCK};
+  std::atomic<bool> writer_idle_{false};   // 写线程正在等待新日志
+  std::atomic<bool> writer_stop_{false};
+  std::atomic<size_t> written_pos_{0};     // 该位置之前的日志已写出或丢弃
+  std::atomic<uint32_t> waiters_{0};       // 等待空间或等待写出的调用方数
+  std::mutex wait_mutex_;
+  std::condition_variable writer_cv_;      // 唤醒写线程
+  std::condition_variable progress_cv_;    // 写线程完成一批
+  std::string console_batch_;              // 写线程复用的终端批量缓冲
+  std::atomic<uint32_t> binary_mask_{0};   // 按二进制记录的级别(1 << level)
+  TimestampCache time_cache_;              // 时间前缀缓存(持有mutex_时使用)
+  std::atomic<uint64_t> enqueued_{0}, dropped_{0}, blocked_{0}, batches_{0};
+
+  // 文件写出策略(持有mutex_时访问)
+  FlushStats flush_stats_;
+  int64_t last_flush_ms_ = 0;
+  int64_t last_sync_ms_ = 0;
+  bool unsynced_ = false; // 上次fdatasync之后有新写出的数据
+
   void UpdateConfig() {
     std::lock_guard<std::mutex> lock(mutex_);
 
@@ -68,6 +219,40 @@ private:
     ini_reader_->GetValue(LEVEL_SECTION, "warn", config_.level_warn);
     ini_reader_->GetValue(LEVEL_SECTION, "debug", config_.level_debug);
     ini_reader_->GetValue(LEVEL_SECTION, "error", config_.level_error);
+    level_mask_.store((config_.level_msg ? 1u << MSG : 0) |
+                          (config_.level_info ? 1u << INFO : 0) |
+                          (config_.level_warn ? 1u << WARN : 0) |
+                          (config_.level_debug ? 1u << DEBUG : 0) |
+                          (config_.level_error ? 1u << ERROR : 0),
+                      std::memory_order_relaxed);
+
+    ini_reader_->GetValue(ASYNC_SECTION, "enable", config_.async);
+    ini_reader_->GetValue(ASYNC_SECTION, "queue_size", config_.queue_size);
+    ini_reader_->GetValue(ASYNC_SECTION, "overflow", config_.overflow);
+    overflow_ = config_.overflow == "drop_oldest" ? DROP_OLDEST
+                : config_.overflow == "drop_new"  ? DROP_NEW
+                                                  : BLOCK;
+
+    ini_reader_->GetValue(BINARY_SECTION, "msg", config_.binary_msg);
+    ini_reader_->GetValue(BINARY_SECTION, "info", config_.binary_info);
+    ini_reader_->GetValue(BINARY_SECTION, "warn", config_.binary_warn);
+    ini_reader_->GetValue(BINARY_SECTION, "debug", config_.binary_debug);
+    ini_reader_->GetValue(BINARY_SECTION, "error", config_.binary_error);
+    binary_mask_ = (config_.binary_msg ? 1u << MSG : 0) |
+                   (config_.binary_info ? 1u << INFO : 0) |
+                   (config_.binary_warn ? 1u << WARN : 0) |
+                   (config_.binary_debug ? 1u << DEBUG : 0) |
+                   (config_.binary_error ? 1u << ERROR : 0);
+
+    ini_reader_->GetValue(FLUSH_SECTION, "interval_ms",
+                          config_.flush_interval_ms);
+    size_t buffer_kb = 0;
+    if (ini_reader_->GetValue(FLUSH_SECTION, "buffer_kb", buffer_kb))
+      config_.buffer_size = buffer_kb * 1024; // KB to bytes
+    ini_reader_->GetValue(FLUSH_SECTION, "warn", config_.flush_warn);
+    ini_reader_->GetValue(FLUSH_SECTION, "error", config_.flush_error);
+    ini_reader_->GetValue(FLUSH_SECTION, "sync_interval_ms",
+                          config_.sync_interval_ms);
   }
 
   void MonitorConfigChanges() {
@@ -80,26 +265,16 @@ private:
           UpdateConfig();
         }
       }
+      // 同步模式没有写线程, 由此写出超时的缓冲数据
+      {
+        std::lock_guard<std::mutex> lock(mutex_);
+        ApplyFlushPolicy(false);
+      }
       std::this_thread::sleep_for(std::chrono::seconds(1));
     }
   }
 
-  bool ShouldLog(LogLevel level) const {
-    switch (level) {
-    case MSG:
-      return config_.level_msg;
-    case INFO:
-      return config_.level_info;
-    case WARN:
-      return config_.level_warn;
-    case DEBUG:
-      return config_.level_debug;
-    case ERROR:
-      return config_.level_error;
-    default:
-      return false;
-    }
-  }
+  bool ShouldLog(LogLevel level) const { return Enabled(level); }
 
   const char *LevelToString(LogLevel level) const {
     static const char *levels[] = {"[MSG] ", "[INFO] ", "[WARN] ", "[DEBUG] ",
@@ -107,57 +282,382 @@ private:
     return levels[level];
   }
 
-  std::string CurrentTime() const {
-    auto now = std::chrono::system_clock::now();
-    auto time = std::chrono::system_clock::to_time_t(now);
-    std::tm tm = *std::localtime(&time);
+  static size_t FormatText(char *buffer, const char *format, ...) {
+    va_list args;
+    va_start(args, format);
+    int length = vsnprintf(buffer, TEXT_CAPACITY, format, args);
+    va_end(args);
+    return length < 0 ? size_t(0) : std::min<size_t>(length, TEXT_CAPACITY - 1);
+  }
+
+  static int64_t SteadyMs() {
+    return std::chrono::duration_cast<std::chrono::milliseconds>(
+               std::chrono::steady_clock::now().time_since_epoch())
+        .count();
+  }
+
+  static int64_t NowNs() {
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(
+               std::chrono::system_clock::now().time_since_epoch())
+        .count();
+  }
 
-    std::ostringstream oss;
-    oss << std::put_time(&tm, "%Y-%m-%d %H:%M:%S");
-    return oss.str();
+  void RotateFileIfNeeded(FileManager &manager, std::string_view date) {
+    if (date != manager.current_date) {
+      manager.current_date = std::string(date);
+      manager.current_index = 0;
+      OpenNewFile(manager);
+    } else if (manager.size > config_.max_file_size) {
+      manager.current_index++;
+      OpenNewFile(manager);
+    }
   }
 
-  std::string CurrentDate() const {
-    auto now = std::chrono::system_clock::now();
-    auto time = std::chrono::system_clock::to_time_t(now);
-    std::tm tm = *std::localtime(&time);
+  void OpenNewFile(FileManager &manager) {
+    CloseFile(manager);
+
+    std::string filename = config_.log_directory + '/' + manager.current_date +
+                           "_" + std::to_string(manager.current_index) +
+                           manager.extension;
 
-    std::ostringstream oss;
-    oss << std::put_time(&tm, "%Y-%m-%d");
-    return oss.str();
+    manager.fd =
+        open(filename.c_str(), O_WRONLY | O_CREAT | O_APPEND | O_CLOEXEC, 0644);
+    if (manager.fd < 0) {
+      throw std::runtime_error("Cannot open log file: " + filename);
+    }
+    const off_t end = lseek(manager.fd, 0, SEEK_END);
+    manager.size = end > 0 ? static_cast<size_t>(end) : 0;
+    manager.pending.reserve(config_.buffer_size);
+
+    // 二进制文件: 新文件写入文件头, 格式定义在每个文件中重新写出
+    if (&manager == &binary_file_) {
+      manager.emitted.clear();
+      if (manager.size == 0) {
+        manager.pending.append(logbin::FILE_MAGIC, sizeof(logbin::FILE_MAGIC));
+        manager.size = sizeof(logbin::FILE_MAGIC);
+      }
+    }
   }
 
-  void RotateFileIfNeeded() {
-    std::string date = CurrentDate();
+  void CloseFile(FileManager &manager) {
+    if (!manager.IsOpen())
+      return;
+    WritePending(manager, FLUSH_OTHER);
+    if (config_.sync_interval_ms > 0) {
+      fdatasync(manager.fd);
+      flush_stats_.syncs++;
+    }
+    close(manager.fd);
+    manager.fd = -1;
+  }
 
-    if (date != file_manager_.current_date) {
-      file_manager_.current_date = date;
-      file_manager_.current_index = 0;
-      OpenNewFile();
-    } else if (file_manager_.file.tellp() > config_.max_file_size) {
-      file_manager_.current_index++;
-      OpenNewFile();
+  /// @brief 用一次write写出文件缓冲(被信号打断或部分写入时继续)
+  void WritePending(FileManager &manager, FlushReason reason) {
+    if (manager.pending.empty() || !manager.IsOpen())
+      return;
+    const char *data = manager.pending.data();
+    size_t left = manager.pending.size();
+    while (left > 0) {
+      const ssize_t n = write(manager.fd, data, left);
+      flush_stats_.writes[reason]++;
+      if (n < 0) {
+        if (errno == EINTR)
+          continue;
+        // 磁盘满等错误: 丢弃本次缓冲, 避免无限增长
+        std::cerr << "LogKit write failed: " << std::strerror(errno)
+                  << std::endl;
+        break;
+      }
+      flush_stats_.bytes[reason] += n;
+      data += n;
+      left -= n;
     }
+    manager.pending.clear();
+    unsynced_ = true;
   }
 
-  void OpenNewFile() {
-    if (file_manager_.file.is_open()) {
-      file_manager_.file.close();
+  void FlushFiles(FlushReason reason) {
+    WritePending(file_manager_, reason);
+    WritePending(binary_file_, reason);
+    last_flush_ms_ = SteadyMs();
+  }
+
+  /// @brief 按配置决定是否写出缓冲与调用fdatasync, 调用方持有mutex_
+  /// @param urgent 本批含需立即写出的级别
+  void ApplyFlushPolicy(bool urgent) {
+    const int64_t now = SteadyMs();
+    const size_t pending =
+        file_manager_.pending.size() + binary_file_.pending.size();
+    if (pending > 0) {
+      if (urgent)
+        FlushFiles(FLUSH_LEVEL);
+      else if (pending >= config_.buffer_size)
+        FlushFiles(FLUSH_BYTES);
+      else if (now - last_flush_ms_ >=
+               static_cast<int64_t>(config_.flush_interval_ms))
+        FlushFiles(FLUSH_INTERVAL);
+    }
+    if (config_.sync_interval_ms > 0 && unsynced_ &&
+        now - last_sync_ms_ >= static_cast<int64_t>(config_.sync_interval_ms)) {
+      for (FileManager *manager : {&file_manager_, &binary_file_}) {
+        if (manager->IsOpen()) {
+          fdatasync(manager->fd);
+          flush_stats_.syncs++;
+        }
+      }
+      unsynced_ = false;
+      last_sync_ms_ = now;
     }
+  }
 
-    std::string filename = config_.log_directory + '/' +
-                           file_manager_.current_date + "_" +
-                           std::to_string(file_manager_.current_index) + ".log";
+  template <typename T> static void AppendRaw(std::string &out, T value) {
+    out.append(reinterpret_cast<const char *>(&value), sizeof(value));
+  }
 
-    file_manager_.file.open(filename, std::ios::app);
-    if (!file_manager_.file.is_open()) {
-      throw std::runtime_error("Cannot open log file: " + filename);
+  static void AppendRawString(std::string &out, const char *text) {
+    const uint16_t length =
+        static_cast<uint16_t>(std::min<size_t>(std::strlen(text), 0xFFFF));
+    AppendRaw(out, length);
+    out.append(text, length);
+  }
+
+  /// @brief 追加一条二进制记录, 该格式ID在当前文件中首次出现时先写出其定义
+  void AppendBinaryRecord(const Entry &entry, std::string &out) {
+    std::vector<bool> &emitted = binary_file_.emitted;
+    if (entry.format_id >= emitted.size())
+      emitted.resize(entry.format_id + 64);
+    if (!emitted[entry.format_id]) {
+      emitted[entry.format_id] = true;
+      if (const FormatSite *site = FindSite(entry.format_id)) {
+        out.push_back(static_cast<char>(logbin::FORMAT));
+        AppendRaw(out, entry.format_id);
+        AppendRaw(out, static_cast<uint8_t>(site->level));
+        AppendRaw(out, site->line);
+        AppendRawString(out, site->func);
+        AppendRawString(out, site->format);
+      }
+    }
+    out.push_back(static_cast<char>(logbin::RECORD));
+    AppendRaw(out, entry.format_id);
+    AppendRaw(out, entry.time_ns);
+    AppendRaw(out, static_cast<uint16_t>(entry.length));
+    out.append(entry.text, entry.length);
+  }
+
+  /// @brief 在栈上组装一条完整的日志行(含时间、级别、函数名与行号)并追加到out
+  /// @return 该条日志的日期, 用于判断是否需要轮转
+  std::string_view FormatEntry(const Entry &entry, std::string &out) {
+    char line[TEXT_CAPACITY + 128];
+    LineWriter writer(line, sizeof(line) - 1);
+    const std::string_view time = time_cache_.Format(entry.time_ns);
+    writer.Append(time);
+    writer.Append(' ');
+    writer.Append(LevelToString(entry.level));
+    if (config_.print_func) {
+      writer.Append(entry.func);
+      writer.Append(' ');
+    }
+    if (config_.print_line) {
+      writer.Append('L');
+      writer.Append(entry.line);
+      writer.Append(' ');
     }
+    writer.Append(entry.text, entry.length);
+    line[writer.Size()] = '\n';
+    out.append(line, writer.Size() + 1);
+    return time.substr(0, 10);
+  }
+
+  /// @brief 将日志追加到文件缓冲(除了MSG级别)并写到终端, 调用方持有mutex_
+  /// @note 文件何时写出由ApplyFlushPolicy()决定; 缓冲区复用容量, 稳态下不分配内存
+  void WriteBatch(const Entry *const *entries, size_t count) {
+    console_batch_.clear();
+    bool urgent = false;
+    for (size_t i = 0; i < count; i++) {
+      const Entry &entry = *entries[i];
+      if (entry.format_id != 0) {
+        // 二进制记录只写.blog文件, 不在此格式化
+        const std::string_view date = time_cache_.Date(entry.time_ns);
+        if (!binary_file_.IsOpen() || date != binary_file_.current_date ||
+            binary_file_.size > config_.max_file_size)
+          RotateFileIfNeeded(binary_file_, date);
+        const size_t before = binary_file_.pending.size();
+        AppendBinaryRecord(entry, binary_file_.pending);
+        binary_file_.size += binary_file_.pending.size() - before;
+      } else {
+        const size_t begin = console_batch_.size();
+        const std::string_view date = FormatEntry(entry, console_batch_);
+        if (entry.level == MSG)
+          continue;
+        // 日期变化或超出大小时轮转(关闭前写出旧文件的缓冲)
+        if (!file_manager_.IsOpen() || date != file_manager_.current_date ||
+            file_manager_.size > config_.max_file_size)
+          RotateFileIfNeeded(file_manager_, date);
+        file_manager_.pending.append(console_batch_, begin, std::string::npos);
+        file_manager_.size += console_batch_.size() - begin;
+      }
+      flush_stats_.lines++;
+      urgent |= (entry.level == WARN && config_.flush_warn) ||
+                (entry.level == ERROR && config_.flush_error);
+    }
+    ApplyFlushPolicy(urgent);
+    if (!console_batch_.empty()) {
+      std::cout.write(console_batch_.data(), console_batch_.size());
+      std::cout.flush();
+    }
+  }
+
+  /// @brief 提交一条日志: 异步模式写入队列, 否则同步写出
+  /// @param fill 在槽位内填写正文, 返回正文长度
+  /// @param format_id 非0时fill写入的是二进制参数
+  template <typename Fill>
+  void Submit(LogLevel level, const char *func, size_t line, Fill &&fill,
+              uint32_t format_id = 0) {
+    if (!queue_) {
+      std::lock_guard<std::mutex> lock(mutex_);
+      Entry entry;
+      entry.time_ns = NowNs();
+      entry.level = level;
+      entry.func = func;
+      entry.line = static_cast<uint32_t>(line);
+      entry.format_id = format_id;
+      entry.length = static_cast<uint32_t>(fill(entry.text));
+      const Entry *entries[] = {&entry};
+      WriteBatch(entries, 1);
+      return;
+    }
+
+    size_t pos;
+    Entry *entry = Claim(pos, level == ERROR ? BLOCK : overflow_.load());
+    if (!entry)
+      return;
+    entry->time_ns = NowNs();
+    entry->level = level;
+    entry->func = func;
+    entry->line = static_cast<uint32_t>(line);
+    entry->format_id = format_id;
+    entry->length = static_cast<uint32_t>(fill(entry->text));
+    queue_->Commit(pos);
+    enqueued_.fetch_add(1, std::memory_order_relaxed);
+    WakeWriter();
+
+    // ERROR之前的日志(含本条)必须落盘, 进程可能随即退出
+    if (level == ERROR)
+      Flush();
+  }
+
+  /// @brief 按溢出策略预留队列槽位, ERROR级别总是等待而不丢弃
+  /// @return 丢弃当前日志时返回nullptr
+  Entry *Claim(size_t &pos, int policy) {
+    while (true) {
+      if (Entry *entry = queue_->TryClaim(pos))
+        return entry;
+      switch (policy) {
+      case DROP_NEW:
+        dropped_.fetch_add(1, std::memory_order_relaxed);
+        return nullptr;
+      case DROP_OLDEST:
+        if (queue_->DropOldest())
+          dropped_.fetch_add(1, std::memory_order_relaxed);
+        break;
+      default: {
+        blocked_.fetch_add(1, std::memory_order_relaxed);
+        WakeWriter();
+        waiters_.fetch_add(1);
+        std::unique_lock<std::mutex> lock(wait_mutex_);
+        progress_cv_.wait_for(lock, std::chrono::milliseconds(1));
+        waiters_.fetch_sub(1);
+        break;
+      }
+      }
+    }
+  }
+
+  void WakeWriter() {
+    // 与写线程的"置空闲标志后检查队列"配对, 保证不会漏掉唤醒
+    // 只由第一个看到空闲标志的调用方发出通知, 写线程被调度前其余调用方不再加锁
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    if (writer_idle_.load(std::memory_order_relaxed) &&
+        writer_idle_.exchange(false)) {
+      std::lock_guard<std::mutex> lock(wait_mutex_);
+      writer_cv_.notify_one();
+    }
+  }
+
+  /// @brief 写线程: 批量取出日志写入文件与终端, 停止前写完队列中的所有日志
+  void WriterLoop() {
+    std::vector<Entry> batch(BATCH_ENTRIES);
+    const Entry *pointers[BATCH_ENTRIES];
+    while (true) {
+      size_t count = 0;
+      while (count < BATCH_ENTRIES &&
+             queue_->TryConsume([&](Entry &entry) {
+               // 只复制有效部分, 槽位随即可被生产者复用
+               std::memcpy(&batch[count], &entry,
+                           offsetof(Entry, text) + entry.length);
+               pointers[count] = &batch[count];
+             }))
+        count++;
+
+      if (count > 0) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        try {
+          WriteBatch(pointers, count);
+        } catch (const std::exception &e) {
+          std::cerr << e.what() << std::endl;
+        }
+        batches_.fetch_add(1, std::memory_order_relaxed);
+      }
+      // 当前取出位置之前的日志都已写出(或被DROP_OLDEST丢弃)
+      written_pos_.store(queue_->DequeuePos());
+      if (waiters_.load() > 0) {
+        std::lock_guard<std::mutex> lock(wait_mutex_);
+        progress_cv_.notify_all();
+      }
+      if (count == BATCH_ENTRIES)
+        continue;
+
+      std::unique_lock<std::mutex> lock(wait_mutex_);
+      writer_idle_.store(true);
+      std::atomic_thread_fence(std::memory_order_seq_cst);
+      if (!queue_->Readable()) {
+        if (writer_stop_.load() &&
+            queue_->DequeuePos() == queue_->EnqueuePos())
+          break;
+        writer_cv_.wait_for(lock, std::chrono::milliseconds(100));
+      }
+      writer_idle_.store(false);
+      lock.unlock();
+
+      // 空闲期间写出超过interval_ms的缓冲数据
+      std::lock_guard<std::mutex> file_lock(mutex_);
+      ApplyFlushPolicy(false);
+    }
+  }
+
+  void StartWriter() {
+    queue_ = std::make_unique<LogQueue<Entry>>(config_.queue_size);
+    writer_ = std::make_unique<std::thread>([this] { WriterLoop(); });
+  }
+
+  void StopWriter() {
+    if (!writer_)
+      return;
+    writer_stop_ = true;
+    {
+      std::lock_guard<std::mutex> lock(wait_mutex_);
+      writer_cv_.notify_one();
+    }
+    writer_->join();
+    writer_.reset();
   }
 
 public:
   LogKit() : ini_reader_(std::make_unique<IniReader>(CONFIG_PATH)) {
+    binary_file_.extension = ".blog";
     UpdateConfig();
+    if (config_.async)
+      StartWriter();
     config_monitor_ =
         std::make_unique<std::thread>([this] { MonitorConfigChanges(); });
   }
@@ -167,9 +667,45 @@ public:
     if (config_monitor_ && config_monitor_->joinable()) {
       config_monitor_->join();
     }
-    if (file_manager_.file.is_open()) {
-      file_manager_.file.close();
+    StopWriter(); // 写完队列中剩余的日志
+    std::lock_guard<std::mutex> lock(mutex_);
+    CloseFile(file_manager_);
+    CloseFile(binary_file_);
+  }
+
+  /// @brief 等待此前提交的日志全部写出, 并写出文件缓冲
+  void Flush() {
+    if (queue_) {
+      const size_t target = queue_->EnqueuePos();
+      waiters_.fetch_add(1);
+      std::unique_lock<std::mutex> lock(wait_mutex_);
+      while (written_pos_.load() < target) {
+        writer_cv_.notify_one();
+        progress_cv_.wait_for(lock, std::chrono::milliseconds(10));
+      }
+      waiters_.fetch_sub(1);
     }
+    std::lock_guard<std::mutex> lock(mutex_);
+    FlushFiles(FLUSH_OTHER);
+  }
+
+  /// @brief 是否为异步模式
+  bool IsAsync() const { return queue_ != nullptr; }
+
+  /// @brief 异步日志统计
+  Stats GetStats() const {
+    Stats stats;
+    stats.enqueued = enqueued_.load(std::memory_order_relaxed);
+    stats.dropped = dropped_.load(std::memory_order_relaxed);
+    stats.blocked = blocked_.load(std::memory_order_relaxed);
+    stats.batches = batches_.load(std::memory_order_relaxed);
+    return stats;
+  }
+
+  /// @brief 日志文件写出统计
+  FlushStats GetFlushStats() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return flush_stats_;
   }
 
   template <typename... Args>
@@ -177,25 +713,11 @@ public:
     if (!ShouldLog(level))
       return;
 
-    std::lock_guard<std::mutex> lock(mutex_);
-
-    std::ostringstream oss;
-    oss << CurrentTime() << " " << LevelToString(level);
-    if (config_.print_func)
-      oss << func << " ";
-    if (config_.print_line)
-      oss << "L" << line << " ";
-    ((oss << std::forward<Args>(args)), ...) << "\n";
-
-    // 输出到文件（除了MSG级别）
-    if (level != MSG) {
-      RotateFileIfNeeded();
-      file_manager_.file << oss.str();
-      file_manager_.file.flush();
-    }
-    
-    // 同时输出到终端
-    std::cout << oss.str();
+    Submit(level, func, line, [&](char *buffer) {
+      LineWriter writer(buffer, TEXT_CAPACITY - 1);
+      (writer.Append(std::forward<Args>(args)), ...);
+      return writer.Size();
+    });
   }
 
   void LogPrint(LogLevel level, const char *func, size_t line,
@@ -203,53 +725,60 @@ public:
     if (!ShouldLog(level))
       return;
 
-    std::lock_guard<std::mutex> lock(mutex_);
-
     va_list args;
     va_start(args, format);
-    char buffer[1024];
-    vsnprintf(buffer, sizeof(buffer), format, args);
+    Submit(level, func, line, [&](char *buffer) {
+      int length = vsnprintf(buffer, TEXT_CAPACITY, format, args);
+      return length < 0 ? size_t(0)
+                        : std::min<size_t>(length, TEXT_CAPACITY - 1);
+    });
     va_end(args);
+  }
 
-    std::ostringstream oss;
-    oss << CurrentTime() << " " << LevelToString(level);
-    if (config_.print_func)
-      oss << func << " ";
-    if (config_.print_line)
-      oss << "L" << line << " ";
-    oss << buffer << "\n";
-
-    // 输出到文件（除了MSG级别）
-    if (level != MSG) {
-      RotateFileIfNeeded();
-      file_manager_.file << oss.str();
-      file_manager_.file.flush();
+  /// @brief LOGP_*入口: 二进制级别只记录格式ID、时间与原始参数, 否则同LogPrint
+  template <typename... Args>
+  void LogFormat(const FormatSite &site, Args... args) {
+    if (!ShouldLog(site.level))
+      return;
+
+    if (binary_mask_.load(std::memory_order_relaxed) & (1u << site.level)) {
+      Submit(
+          site.level, site.func, site.line,
+          [&](char *buffer) {
+            logbin::ArgEncoder encoder(buffer, TEXT_CAPACITY);
+            (encoder.Append(args), ...);
+            return encoder.Size();
+          },
+          site.id);
+      return;
     }
-    
-    // 同时输出到终端
-    std::cout << oss.str();
+    Submit(site.level, site.func, site.line, [&](char *buffer) {
+      return FormatText(buffer, site.format, args...);
+    });
   }
   template <typename T>
   void LogVector(LogLevel level, const char *func, size_t line,
                  const std::vector<T> &vector) {
+    if (!ShouldLog(level))
+      return;
 
-    std::ostringstream oss;
-    oss << CurrentTime() << " " << LevelToString(level);
-    if (config_.print_func)
-      oss << func << " ";
-    if (config_.print_line)
-      oss << "L" << line << " ";
-
-    for (size_t i = 0; i < vector.size(); ++i) {
-      if (i != 0) // 首行不加
-        oss << ",";
-      if (sizeof(vector[i]) == 1)
-        oss << (size_t)vector[i];
-      else
-        oss << vector[i];
-    }
-    oss << "\n";
-    std::cout << oss.str();
+    Submit(level, func, line, [&](char *buffer) {
+      LineWriter writer(buffer, TEXT_CAPACITY - 1);
+      for (size_t i = 0; i < vector.size(); ++i) {
+        if (i != 0) // 首行不加
+          writer.Append(',');
+        if (sizeof(vector[i]) == 1)
+          writer.Append((size_t)vector[i]);
+        else
+          writer.Append(vector[i]);
+      }
+      return writer.Size();
+    });
+  }
+
+  /// @brief 级别是否启用(一次relaxed读取, 不需要实例)
+  static bool Enabled(LogLevel level) {
+    return (level_mask_.load(std::memory_order_relaxed) >> level) & 1u;
   }
 
   static LogKit &Instance() {
@@ -258,32 +787,65 @@ public:
   }
 };
 
-#define LOG_MSG(...)                                                           \
-  LogKit::Instance().LogCout(LogKit::MSG, __func__, __LINE__, __VA_ARGS__)
-#define LOG_INFO(...)                                                          \
-  LogKit::Instance().LogCout(LogKit::INFO, __func__, __LINE__, __VA_ARGS__)
-#define LOG_WARN(...)                                                          \
-  LogKit::Instance().LogCout(LogKit::WARN, __func__, __LINE__, __VA_ARGS__)
-#define LOG_DEBUG(...)                                                         \
-  LogKit::Instance().LogCout(LogKit::DEBUG, __func__, __LINE__, __VA_ARGS__)
-#define LOG_ERROR(...)                                                         \
-  LogKit::Instance().LogCout(LogKit::ERROR, __func__, __LINE__, __VA_ARGS__)
-
-#define LOGP_MSG(fmt, ...)                                                     \
-  LogKit::Instance().LogPrint(LogKit::MSG, __func__, __LINE__, fmt,            \
-                              ##__VA_ARGS__)
-#define LOGP_INFO(fmt, ...)                                                    \
-  LogKit::Instance().LogPrint(LogKit::INFO, __func__, __LINE__, fmt,           \
-                              ##__VA_ARGS__)
-#define LOGP_WARN(fmt, ...)                                                    \
-  LogKit::Instance().LogPrint(LogKit::WARN, __func__, __LINE__, fmt,           \
-                              ##__VA_ARGS__)
-#define LOGP_DEBUG(fmt, ...)                                                   \
-  LogKit::Instance().LogPrint(LogKit::DEBUG, __func__, __LINE__, fmt,          \
-                              ##__VA_ARGS__)
-#define LOGP_ERROR(fmt, ...)                                                   \
-  LogKit::Instance().LogPrint(LogKit::ERROR, __func__, __LINE__, fmt,          \
-                              ##__VA_ARGS__)
-
+/// @brief 先检查级别再求值参数, 禁用的级别只有一次relaxed读取
+#define LOGKIT_COUT(level, ...)                                                \
+  do {                                                                         \
+    if (LogKit::Enabled(level))                                                \
+      LogKit::Instance().LogCout(level, __func__, __LINE__, __VA_ARGS__);      \
+  } while (0)
+
+/// @brief 每个调用点持有一个静态FormatSite, 格式串只在首次执行时注册
+#define LOGKIT_FORMAT(level, fmt, ...)                                         \
+  do {                                                                         \
+    if (LogKit::Enabled(level)) {                                              \
+      static const LogKit::FormatSite logkit_site_(level, __func__, __LINE__,  \
+                                                   fmt);                       \
+      LogKit::Instance().LogFormat(logkit_site_, ##__VA_ARGS__);               \
+    }                                                                          \
+  } while (0)
+
+#define LOGKIT_DISABLED(...)                                                   \
+  do {                                                                         \
+  } while (0)
+
+#if LOGKIT_MIN_LEVEL <= LOGKIT_LEVEL_DEBUG
+#define LOG_DEBUG(...) LOGKIT_COUT(LogKit::DEBUG, __VA_ARGS__)
+#define LOGP_DEBUG(fmt, ...) LOGKIT_FORMAT(LogKit::DEBUG, fmt, ##__VA_ARGS__)
+#else
+#define LOG_DEBUG(...) LOGKIT_DISABLED()
+#define LOGP_DEBUG(fmt, ...) LOGKIT_DISABLED()
+#endif
+
+#if LOGKIT_MIN_LEVEL <= LOGKIT_LEVEL_INFO
+#define LOG_MSG(...) LOGKIT_COUT(LogKit::MSG, __VA_ARGS__)
+#define LOG_INFO(...) LOGKIT_COUT(LogKit::INFO, __VA_ARGS__)
+#define LOGP_MSG(fmt, ...) LOGKIT_FORMAT(LogKit::MSG, fmt, ##__VA_ARGS__)
+#define LOGP_INFO(fmt, ...) LOGKIT_FORMAT(LogKit::INFO, fmt, ##__VA_ARGS__)
 #define LOG_VECTOR(vector)                                                     \
-  LogKit::Instance().LogVector(LogKit::MSG, __func__, __LINE__, vector)
+  do {                                                                         \
+    if (LogKit::Enabled(LogKit::MSG))                                          \
+      LogKit::Instance().LogVector(LogKit::MSG, __func__, __LINE__, vector);   \
+  } while (0)
+#else
+#define LOG_MSG(...) LOGKIT_DISABLED()
+#define LOG_INFO(...) LOGKIT_DISABLED()
+#define LOGP_MSG(fmt, ...) LOGKIT_DISABLED()
+#define LOGP_INFO(fmt, ...) LOGKIT_DISABLED()
+#define LOG_VECTOR(vector) LOGKIT_DISABLED()
+#endif
+
+#if LOGKIT_MIN_LEVEL <= LOGKIT_LEVEL_WARN
+#define LOG_WARN(...) LOGKIT_COUT(LogKit::WARN, __VA_ARGS__)
+#define LOGP_WARN(fmt, ...) LOGKIT_FORMAT(LogKit::WARN, fmt, ##__VA_ARGS__)
+#else
+#define LOG_WARN(...) LOGKIT_DISABLED()
+#define LOGP_WARN(fmt, ...) LOGKIT_DISABLED()
+#endif
+
+#if LOGKIT_MIN_LEVEL <= LOGKIT_LEVEL_ERROR
+#define LOG_ERROR(...) LOGKIT_COUT(LogKit::ERROR, __VA_ARGS__)
+#define LOGP_ERROR(fmt, ...) LOGKIT_FORMAT(LogKit::ERROR, fmt, ##__VA_ARGS__)
+#else
+#define LOG_ERROR(...) LOGKIT_DISABLED()
+#define LOGP_ERROR(fmt, ...) LOGKIT_DISABLED()
+#endif
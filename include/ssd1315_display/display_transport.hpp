@@ -0,0 +1,444 @@
+#pragma once
+#include <cerrno>
+#include <cstdint>
+#include <cstring>
+#include <fcntl.h>
+#include <iostream>
+#include <linux/gpio.h>
+#include <linux/i2c-dev.h>
+#include <linux/i2c.h>
+#include <linux/spi/spidev.h>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <sys/ioctl.h>
+#include <unistd.h>
+#include <vector>
+
+/// @brief 一段帧数据: 单页内的列窗口及其数据
+struct FrameSegment {
+  uint8_t page;        // 页号
+  uint8_t first_col;   // 起始列
+  uint8_t last_col;    // 结束列
+  const uint8_t *data; // 数据(last_col - first_col + 1 字节)
+};
+
+/// @brief 传输统计
+struct TransportStats {
+  uint64_t bytes_sent{0}; // 实际发送的字节数(含控制字节与命令)
+  uint64_t syscalls{0};   // 发送数据产生的系统调用次数
+};
+
+/// @brief 显示传输层接口, 负责把命令与帧数据送达面板
+class DisplayTransport {
+protected:
+  TransportStats stats_;
+
+public:
+  virtual ~DisplayTransport() = default;
+
+  /// @brief 传输通道是否可用
+  virtual bool IsOpen() const = 0;
+
+  /// @brief 批量下发命令
+  /// @param commands 命令序列
+  /// @param len 命令字节数
+  /// @return
+  virtual bool SendCommands(const uint8_t *commands, size_t len) = 0;
+
+  /// @brief 发送一帧中所有变化段(地址窗口 + 数据)
+  /// @param segments 数据段数组
+  /// @param count 数据段数量
+  /// @return 全部发送成功返回true
+  virtual bool SendFrame(const FrameSegment *segments, size_t count) = 0;
+
+  /// @brief 获取传输统计
+  const TransportStats &Stats() const { return stats_; }
+
+  /// @brief 清零传输统计
+  void ResetStats() { stats_ = TransportStats{}; }
+
+protected:
+  /// @brief 构造单段地址窗口命令: 0x21,起,止 + 0x22,起,止
+  static void BuildWindowCommands(uint8_t *commands,
+                                  const FrameSegment &segment) {
+    commands[0] = 0x21; // 设置列地址命令
+    commands[1] = segment.first_col;
+    commands[2] = segment.last_col;
+    commands[3] = 0x22; // 设置页地址命令
+    commands[4] = segment.page;
+    commands[5] = segment.page;
+  }
+  static constexpr size_t WINDOW_COMMANDS_SIZE = 6;
+  static constexpr size_t MAX_SEGMENT_SIZE = 128;
+};
+
+/// @brief I2C传输: 帧数据合并为一次I2C_RDWR
+class I2cTransport : public DisplayTransport {
+private:
+  static constexpr size_t MAX_SEGMENTS = 16; // 单次I2C_RDWR最多携带的段数
+
+  std::string dev_path_;        // I2C设备路径
+  uint8_t address_;             // 从设备地址
+  int fd_ = -1;                 // I2C文件描述符
+  bool rdwr_supported_ = false; // 适配器是否支持I2C_RDWR组合传输
+
+  /// @brief 通过I2C_RDWR一次提交多段写消息
+  /// @param msgs 消息数组
+  /// @param count 消息数量
+  /// @return 全部发送成功返回true
+  bool TransferMessages(i2c_msg *msgs, size_t count) {
+    if (rdwr_supported_) {
+      i2c_rdwr_ioctl_data data{msgs, static_cast<uint32_t>(count)};
+      stats_.syscalls++;
+      if (ioctl(fd_, I2C_RDWR, &data) >= 0)
+        return true;
+      // 仅在适配器明确不支持时回退; NACK/超时等瞬时错误只放弃本帧
+      if (errno != EOPNOTSUPP && errno != ENOTTY && errno != EINVAL) {
+        std::cerr << "I2C_RDWR传输失败: " << std::strerror(errno)
+                  << std::endl;
+        return false;
+      }
+      std::cerr << "适配器不支持I2C_RDWR, 回退为逐段写入" << std::endl;
+      rdwr_supported_ = false;
+    }
+
+    // 不支持组合传输时逐段write
+    for (size_t i = 0; i < count; i++) {
+      stats_.syscalls++;
+      if (write(fd_, msgs[i].buf, msgs[i].len) != msgs[i].len)
+        return false;
+    }
+    return true;
+  }
+
+public:
+  /// @brief 打开I2C设备
+  /// @param dev_path 设备路径, 如/dev/i2c-3
+  /// @param address 从设备地址
+  I2cTransport(std::string dev_path, uint8_t address)
+      : dev_path_(std::move(dev_path)), address_(address) {
+    fd_ = open(dev_path_.c_str(), O_RDWR);
+    if (fd_ < 0)
+      throw std::runtime_error("无法打开I2C设备: " + dev_path_);
+    // 设置从设备地址
+    if (ioctl(fd_, I2C_SLAVE, address_) < 0) {
+      close(fd_);
+      fd_ = -1;
+      throw std::runtime_error("无法设置I2C从设备地址: " + dev_path_);
+    }
+    // 查询适配器是否支持组合传输
+    unsigned long funcs = 0;
+    rdwr_supported_ =
+        ioctl(fd_, I2C_FUNCS, &funcs) >= 0 && (funcs & I2C_FUNC_I2C);
+  }
+
+  I2cTransport(const I2cTransport &) = delete;
+  I2cTransport &operator=(const I2cTransport &) = delete;
+
+  bool IsOpen() const override { return fd_ >= 0; }
+
+  bool SendCommands(const uint8_t *commands, size_t len) override {
+    uint8_t packet[33];
+    if (len == 0 || len > sizeof(packet) - 1)
+      return false;
+
+    packet[0] = 0x00; // Co=0, D/C=0(命令模式)
+    std::memcpy(packet + 1, commands, len);
+    stats_.syscalls++;
+    if (write(fd_, packet, len + 1) != static_cast<ssize_t>(len + 1)) {
+      std::cerr << "发送命令失败: 0x" << std::hex << (int)commands[0]
+                << std::dec << std::endl;
+      return false;
+    }
+    stats_.bytes_sent += len + 1;
+    return true;
+  }
+
+  bool SendFrame(const FrameSegment *segments, size_t count) override {
+    uint8_t window_packets[MAX_SEGMENTS][WINDOW_COMMANDS_SIZE + 1];
+    uint8_t data_packets[MAX_SEGMENTS][MAX_SEGMENT_SIZE + 1];
+    i2c_msg msgs[MAX_SEGMENTS * 2];
+
+    while (count > 0) {
+      size_t batch = count < MAX_SEGMENTS ? count : MAX_SEGMENTS;
+      size_t batch_bytes = 0;
+      for (size_t i = 0; i < batch; i++) {
+        const FrameSegment &seg = segments[i];
+        uint16_t len = seg.last_col - seg.first_col + 1;
+        window_packets[i][0] = 0x00; // Co=0, D/C=0(连续命令)
+        BuildWindowCommands(window_packets[i] + 1, seg);
+        data_packets[i][0] = 0x40; // 数据模式控制字节
+        std::memcpy(data_packets[i] + 1, seg.data, len);
+
+        msgs[i * 2] = {address_, 0, WINDOW_COMMANDS_SIZE + 1,
+                       window_packets[i]};
+        msgs[i * 2 + 1] = {address_, 0, static_cast<uint16_t>(len + 1),
+                           data_packets[i]};
+        batch_bytes += WINDOW_COMMANDS_SIZE + 1 + len + 1;
+      }
+      if (!TransferMessages(msgs, batch * 2))
+        return false;
+      stats_.bytes_sent += batch_bytes;
+      segments += batch;
+      count -= batch;
+    }
+    return true;
+  }
+
+  ~I2cTransport() override {
+    if (fd_ >= 0)
+      close(fd_);
+  }
+};
+
+/// @brief SPI传输: spidev发送数据, GPIO字符设备控制D/C引脚
+class SpiTransport : public DisplayTransport {
+private:
+  std::string dev_path_; // spidev设备路径
+  int spi_fd_ = -1;      // spidev文件描述符
+  int dc_fd_ = -1;       // D/C引脚句柄
+  int dc_level_ = -1;    // D/C引脚当前电平, 用于省略重复设置
+
+  /// @brief 设置D/C引脚电平: 0-命令, 1-数据
+  bool SetDataMode(int level) {
+    if (dc_level_ == level)
+      return true;
+    gpiohandle_data data{};
+    data.values[0] = static_cast<uint8_t>(level);
+    stats_.syscalls++;
+    if (ioctl(dc_fd_, GPIOHANDLE_SET_LINE_VALUES_IOCTL, &data) < 0)
+      return false;
+    dc_level_ = level;
+    return true;
+  }
+
+  /// @brief 写入SPI总线
+  bool WriteBytes(const uint8_t *bytes, size_t len) {
+    stats_.syscalls++;
+    if (write(spi_fd_, bytes, len) != static_cast<ssize_t>(len))
+      return false;
+    stats_.bytes_sent += len;
+    return true;
+  }
+
+  void CloseAll() {
+    if (dc_fd_ >= 0)
+      close(dc_fd_);
+    if (spi_fd_ >= 0)
+      close(spi_fd_);
+    dc_fd_ = spi_fd_ = -1;
+  }
+
+public:
+  /// @brief 打开SPI设备与D/C引脚
+  /// @param spi_device spidev路径, 如/dev/spidev1.0
+  /// @param speed_hz SPI时钟频率
+  /// @param gpio_chip D/C所在GPIO控制器, 如/dev/gpiochip0
+  /// @param dc_line D/C引脚在控制器内的编号
+  SpiTransport(std::string spi_device, uint32_t speed_hz,
+               const std::string &gpio_chip, uint32_t dc_line)
+      : dev_path_(std::move(spi_device)) {
+    spi_fd_ = open(dev_path_.c_str(), O_RDWR);
+    if (spi_fd_ < 0)
+      throw std::runtime_error("无法打开SPI设备: " + dev_path_);
+
+    uint8_t mode = SPI_MODE_0;
+    uint8_t bits = 8;
+    if (ioctl(spi_fd_, SPI_IOC_WR_MODE, &mode) < 0 ||
+        ioctl(spi_fd_, SPI_IOC_WR_BITS_PER_WORD, &bits) < 0 ||
+        ioctl(spi_fd_, SPI_IOC_WR_MAX_SPEED_HZ, &speed_hz) < 0) {
+      CloseAll();
+      throw std::runtime_error("无法配置SPI设备: " + dev_path_);
+    }
+
+    int chip_fd = open(gpio_chip.c_str(), O_RDWR);
+    if (chip_fd < 0) {
+      CloseAll();
+      throw std::runtime_error("无法打开GPIO控制器: " + gpio_chip);
+    }
+    gpiohandle_request request{};
+    request.lineoffsets[0] = dc_line;
+    request.lines = 1;
+    request.flags = GPIOHANDLE_REQUEST_OUTPUT;
+    std::strncpy(request.consumer_label, "ssd1315-dc",
+                 sizeof(request.consumer_label) - 1);
+    int ret = ioctl(chip_fd, GPIO_GET_LINEHANDLE_IOCTL, &request);
+    close(chip_fd);
+    if (ret < 0) {
+      CloseAll();
+      throw std::runtime_error("无法申请D/C引脚: " + gpio_chip);
+    }
+    dc_fd_ = request.fd;
+    dc_level_ = 0;
+  }
+
+  SpiTransport(const SpiTransport &) = delete;
+  SpiTransport &operator=(const SpiTransport &) = delete;
+
+  bool IsOpen() const override { return spi_fd_ >= 0 && dc_fd_ >= 0; }
+
+  bool SendCommands(const uint8_t *commands, size_t len) override {
+    if (!SetDataMode(0) || !WriteBytes(commands, len)) {
+      std::cerr << "发送SPI命令失败" << std::endl;
+      return false;
+    }
+    return true;
+  }
+
+  bool SendFrame(const FrameSegment *segments, size_t count) override {
+    uint8_t window[WINDOW_COMMANDS_SIZE];
+    for (size_t i = 0; i < count; i++) {
+      const FrameSegment &seg = segments[i];
+      BuildWindowCommands(window, seg);
+      if (!SetDataMode(0) || !WriteBytes(window, sizeof(window)) ||
+          !SetDataMode(1) ||
+          !WriteBytes(seg.data, seg.last_col - seg.first_col + 1))
+        return false;
+    }
+    return true;
+  }
+
+  ~SpiTransport() override { CloseAll(); }
+};
+
+/// @brief 内存传输: 模拟面板显存, 可选把每帧写入PBM文件
+/// @note 无需硬件即可运行完整UI流程与基准测试, syscalls按等效I2C传输次数计
+class MemoryTransport : public DisplayTransport {
+private:
+  uint16_t width_;
+  uint16_t pages_;
+  std::vector<uint8_t> gddram_; // 模拟显存(页优先布局)
+  std::string dump_path_;       // 帧输出文件, 为空则不输出
+  uint64_t frames_received_ = 0;
+
+  // 地址窗口与写指针
+  uint16_t col_start_ = 0, col_end_ = 0, page_start_ = 0, page_end_ = 0;
+  uint16_t col_ = 0, page_ = 0;
+
+  // 命令解析状态: 等待参数的命令及剩余参数个数
+  uint8_t pending_cmd_ = 0;
+  uint8_t pending_args_ = 0;
+  uint8_t args_[2] = {0, 0};
+
+  /// @brief 命令所需参数个数
+  static uint8_t ArgCount(uint8_t cmd) {
+    switch (cmd) {
+    case 0x21: // 列地址
+    case 0x22: // 页地址
+      return 2;
+    case 0x20: // 内存地址模式
+    case 0x81: // 对比度
+    case 0x8D: // 电荷泵
+    case 0xA8: // 复用率
+    case 0xD3: // 显示偏移
+    case 0xD5: // 时钟分频
+    case 0xD9: // 预充电周期
+    case 0xDA: // COM管脚配置
+    case 0xDB: // VCOMH电平
+      return 1;
+    default:
+      return 0;
+    }
+  }
+
+  void ExecuteCommand(uint8_t cmd) {
+    if (cmd == 0x21) {
+      col_start_ = col_ = args_[0] < width_ ? args_[0] : width_ - 1;
+      col_end_ = args_[1] < width_ ? args_[1] : width_ - 1;
+    } else if (cmd == 0x22) {
+      page_start_ = page_ = args_[0] < pages_ ? args_[0] : pages_ - 1;
+      page_end_ = args_[1] < pages_ ? args_[1] : pages_ - 1;
+    }
+  }
+
+  void FeedCommand(uint8_t byte) {
+    if (pending_args_ > 0) {
+      args_[ArgCount(pending_cmd_) - pending_args_] = byte;
+      if (--pending_args_ == 0)
+        ExecuteCommand(pending_cmd_);
+      return;
+    }
+    pending_cmd_ = byte;
+    pending_args_ = ArgCount(byte);
+    if (pending_args_ == 0)
+      ExecuteCommand(byte);
+  }
+
+  /// @brief 按水平寻址模式写入显存
+  void FeedData(const uint8_t *data, size_t len) {
+    for (size_t i = 0; i < len; i++) {
+      gddram_[page_ * width_ + col_] = data[i];
+      if (col_ < col_end_) {
+        col_++;
+        continue;
+      }
+      col_ = col_start_;
+      page_ = page_ < page_end_ ? page_ + 1 : page_start_;
+    }
+  }
+
+  /// @brief 以PBM(P4)格式输出当前显存
+  void DumpFrame() const {
+    int fd = open(dump_path_.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0644);
+    if (fd < 0)
+      return;
+    std::string header = "P4\n" + std::to_string(width_) + " " +
+                         std::to_string(pages_ * 8) + "\n";
+    const size_t row_bytes = (width_ + 7) / 8;
+    std::vector<uint8_t> image(row_bytes * pages_ * 8, 0);
+    for (uint16_t y = 0; y < pages_ * 8; y++) {
+      for (uint16_t x = 0; x < width_; x++) {
+        if (gddram_[(y / 8) * width_ + x] & (1 << (y & 7)))
+          image[y * row_bytes + x / 8] |= 0x80 >> (x & 7);
+      }
+    }
+    if (write(fd, header.data(), header.size()) > 0)
+      (void)!write(fd, image.data(), image.size());
+    close(fd);
+  }
+
+public:
+  /// @brief 创建内存面板
+  /// @param width 面板宽度(像素)
+  /// @param height 面板高度(像素)
+  /// @param dump_path 每帧输出的PBM文件路径, 为空则仅保存在内存
+  MemoryTransport(uint16_t width, uint16_t height, std::string dump_path = "")
+      : width_(width), pages_(height / 8), gddram_(width * (height / 8), 0),
+        dump_path_(std::move(dump_path)), col_end_(width - 1),
+        page_end_(height / 8 - 1) {}
+
+  bool IsOpen() const override { return true; }
+
+  bool SendCommands(const uint8_t *commands, size_t len) override {
+    for (size_t i = 0; i < len; i++)
+      FeedCommand(commands[i]);
+    stats_.syscalls++;
+    stats_.bytes_sent += len + 1;
+    return true;
+  }
+
+  bool SendFrame(const FrameSegment *segments, size_t count) override {
+    uint8_t window[WINDOW_COMMANDS_SIZE];
+    for (size_t i = 0; i < count; i++) {
+      const FrameSegment &seg = segments[i];
+      size_t len = seg.last_col - seg.first_col + 1;
+      BuildWindowCommands(window, seg);
+      for (uint8_t cmd : window)
+        FeedCommand(cmd);
+      FeedData(seg.data, len);
+      stats_.bytes_sent += WINDOW_COMMANDS_SIZE + 1 + len + 1;
+    }
+    stats_.syscalls++;
+    frames_received_++;
+    if (!dump_path_.empty())
+      DumpFrame();
+    return true;
+  }
+
+  /// @brief 模拟显存内容(页优先布局)
+  const std::vector<uint8_t> &Gddram() const { return gddram_; }
+
+  /// @brief 已接收的帧数
+  uint64_t FramesReceived() const { return frames_received_; }
+};
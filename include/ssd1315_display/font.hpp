@@ -1,5 +1,6 @@
 #pragma once
 
+#include <array>
 #include <cstdint>
 
 namespace fonts {
@@ -102,4 +103,35 @@ constexpr uint8_t FONT_5X8[] = {
     0x00, 0x41, 0x36, 0x08, 0x00, // 125 : }
     0x08, 0x04, 0x08, 0x10, 0x08, // 126 : ~
 };
+
+constexpr char FONT_5X8_FIRST = 32;  // 首个字符
+constexpr char FONT_5X8_LAST = 126;  // 最后一个字符
+constexpr uint8_t FONT_5X8_COLS = 5; // 每个字符的列数
+
+/// @brief 将字模列的每一位纵向放大scale倍(最低位为顶部)
+/// @param column 字模列数据
+/// @param scale 放大倍数(1-8)
+constexpr uint64_t ScaleColumn(uint8_t column, uint8_t scale) {
+  uint64_t scaled = 0;
+  const uint64_t run = (scale >= 64) ? ~0ULL : ((1ULL << scale) - 1);
+  for (uint8_t bit = 0; bit < 8; bit++) {
+    if (column & (1 << bit))
+      scaled |= run << (bit * scale);
+  }
+  return scaled;
+}
+
+/// @brief 编译期生成放大后的字模列表
+template <uint8_t SCALE>
+constexpr std::array<uint32_t, sizeof(FONT_5X8)> BuildScaledFont5x8() {
+  static_assert(SCALE >= 2 && SCALE <= 4, "缓存仅覆盖2-4倍字体");
+  std::array<uint32_t, sizeof(FONT_5X8)> columns{};
+  for (size_t i = 0; i < sizeof(FONT_5X8); i++)
+    columns[i] = static_cast<uint32_t>(ScaleColumn(FONT_5X8[i], SCALE));
+  return columns;
+}
+
+/// @brief 预放大的5x8字模缓存(2-4倍)
+template <uint8_t SCALE>
+inline constexpr auto SCALED_FONT_5X8 = BuildScaledFont5x8<SCALE>();
 } // namespace fonts
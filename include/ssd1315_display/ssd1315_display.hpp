@@ -1,140 +1,462 @@
 #pragma once
+#include "display_transport.hpp"
 #include "font.hpp"
+#include <algorithm>
+#include <array>
+#include <condition_variable>
 #include <cstdint>
+#include <cstdlib>
 #include <cstring>
-#include <fcntl.h>
 #include <iostream>
-#include <linux/i2c-dev.h>
+#include <memory>
+#include <mutex>
 #include <string>
-#include <sys/ioctl.h>
-#include <unistd.h>
+#include <thread>
 
 /* OLED硬件参数定义 */
 constexpr uint8_t SSD1315_I2C_ADDRESS = 0x3C; // OLED的I2C地址
-constexpr uint16_t SSD1315_WIDTH = 128;       // OLED宽度（像素）
-constexpr uint16_t SSD1315_HEIGHT = 64;       // OLED高度（像素）
-constexpr uint8_t SSD1315_PAGES = 8;          // OLED页数（高度/8）
-constexpr size_t SSD1315_BUFFER_SIZE =        // 显示缓冲区大小
-    (SSD1315_WIDTH * SSD1315_HEIGHT / 8);
+constexpr uint16_t SSD1315_RAM_COLUMNS = 128; // 控制器显存列数
+
+/// @brief 刷新统计
+struct DisplayFlushStats {
+  uint64_t frames{0};         // RefreshDisplay调用次数
+  uint64_t skipped_frames{0}; // 内容无变化而跳过的帧数
+  uint64_t coalesced_frames{0}; // 异步模式下被更新帧覆盖而未发送的帧数
+  uint64_t pages_sent{0};     // 实际发送的页数
+  uint64_t bytes_sent{0};     // 实际发送的字节数(含控制字节与命令)
+  uint64_t syscalls{0};       // 发送数据产生的系统调用次数
+};
+
+/// @brief SSD1315显示驱动, 几何参数在编译期确定
+/// @tparam W 面板宽度(像素)
+/// @tparam H 面板高度(像素, 8的倍数)
+template <uint16_t W = 128, uint16_t H = 64> class SSD1315Display {
+public:
+  static_assert(W > 0 && W <= SSD1315_RAM_COLUMNS, "面板宽度超出控制器范围");
+  static_assert(H > 0 && H <= 64 && H % 8 == 0,
+                "面板高度需为8的倍数且不超过64");
+
+  static constexpr uint16_t WIDTH = W;             // OLED宽度（像素）
+  static constexpr uint16_t HEIGHT = H;            // OLED高度（像素）
+  static constexpr uint8_t PAGES = H / 8;          // OLED页数（高度/8）
+  static constexpr size_t BUFFER_SIZE = W * H / 8; // 显示缓冲区大小
+  static constexpr uint8_t COL_OFFSET =            // 面板在显存中的起始列
+      (SSD1315_RAM_COLUMNS - W) / 2;
+
+  static constexpr uint8_t COM_PINS =              // COM管脚配置(32行为顺序模式)
+      H == 32 ? 0x02 : 0x12;
+
+  using FrameBuffer = std::array<uint8_t, BUFFER_SIZE>;
 
-class SSD1315Display {
 private:
-  std::string i2c_dev_path_;  // I2C设备路径
-  int i2c_fd_ = -1;           // I2C文件描述符
-  uint8_t *buffer_ = nullptr; // 显示缓冲区
+  std::unique_ptr<DisplayTransport> transport_; // 传输层(I2C/SPI/内存)
+  FrameBuffer buffer_{};      // 显示缓冲区
+  FrameBuffer shadow_{};      // 屏幕当前内容镜像
+  bool shadow_valid_ = false; // 镜像是否与屏幕一致
+  DisplayFlushStats flush_stats_;
+  std::mutex flush_mutex_; // 保护传输层、镜像与统计
+
+  /// @brief 异步刷新状态: 渲染线程提交到pending, 刷新线程交换后发送
+  struct AsyncFlush {
+    std::mutex mutex;
+    std::condition_variable submitted; // 有新帧或需要停止
+    std::condition_variable idle;      // 提交的帧已全部发送
+    std::thread worker;
+    FrameBuffer frames[2];
+    uint8_t *pending = frames[0].data();  // 最新提交、尚未发送的帧
+    uint8_t *flushing = frames[1].data(); // 刷新线程正在发送的帧
+    bool pending_ready = false;
+    bool busy = false;
+    bool stop = false;
+    uint64_t coalesced = 0; // 被覆盖而未发送的帧数
+  };
+  std::unique_ptr<AsyncFlush> async_;
 
 private:
-  /// @brief 设置页地址
-  /// @param page 页地址(0-7)
-  void SetPageAddress(uint8_t page) {
-    SendCommand(0x22); // 设置页地址命令
-    SendCommand(page); // 起始页
-    SendCommand(0x07); // 结束页(共8页)
+  /// @brief 查找页内与屏幕镜像不同的列范围
+  /// @param frame 待发送的帧
+  /// @param page 页号
+  /// @param first 输出: 第一个变化列
+  /// @param last 输出: 最后一个变化列
+  /// @return 该页是否有变化
+  bool FindDirtyColumns(const uint8_t *frame, uint8_t page, uint16_t &first,
+                        uint16_t &last) const {
+    const uint8_t *cur = frame + page * WIDTH;
+    const uint8_t *shd = shadow_.data() + page * WIDTH;
+
+    if (!shadow_valid_) {
+      first = 0;
+      last = WIDTH - 1;
+      return true;
+    }
+    if (std::memcmp(cur, shd, WIDTH) == 0)
+      return false;
+
+    first = 0;
+    while (cur[first] == shd[first])
+      first++;
+    last = WIDTH - 1;
+    while (cur[last] == shd[last])
+      last--;
+    return true;
+  }
+
+  /// @brief 按页掩码填充一段连续列
+  /// @param dst 起始字节
+  /// @param len 列数
+  /// @param mask 页内位掩码
+  /// @param color 颜色: 0-黑色, 1-白色, 2-反转
+  static void FillSpan(uint8_t *dst, int16_t len, uint8_t mask,
+                       uint8_t color) {
+    switch (color) {
+    case 1: // 设置像素（白色）
+      if (mask == 0xFF) {
+        std::memset(dst, 0xFF, len);
+      } else {
+        for (int16_t i = 0; i < len; i++)
+          dst[i] |= mask;
+      }
+      break;
+    case 0: // 清除像素（黑色）
+      if (mask == 0xFF) {
+        std::memset(dst, 0x00, len);
+      } else {
+        for (int16_t i = 0; i < len; i++)
+          dst[i] &= ~mask;
+      }
+      break;
+    case 2: // 反转像素
+      for (int16_t i = 0; i < len; i++)
+        dst[i] ^= mask;
+      break;
+    }
   }
 
-  /// @brief 设置列地址
-  /// @param col 起始列地址
-  void SetColumnAddress(uint8_t col) {
-    SendCommand(0x21);              // 设置列地址命令
-    SendCommand(col);               // 起始列
-    SendCommand(SSD1315_WIDTH - 1); // 结束列
+  /// @brief 按颜色把一个字节的位写入显存, 未置位的位保持不变
+  static void ApplyByte(uint8_t *dst, uint8_t bits, uint8_t color) {
+    switch (color) {
+    case 1:
+      *dst |= bits;
+      break;
+    case 0:
+      *dst &= ~bits;
+      break;
+    case 2:
+      *dst ^= bits;
+      break;
+    }
+  }
+
+  /// @brief 将一列位图(最低位为顶部)写入显存, 跨页时移位拆分
+  /// @param x 列X坐标
+  /// @param y 列顶部Y坐标
+  /// @param bits 列位图(最多64位)
+  /// @param color 颜色
+  void BlitColumn(int16_t x, int16_t y, uint64_t bits, uint8_t color) {
+    if (x < 0 || x >= Width() || bits == 0)
+      return;
+    // 裁剪屏幕上方的部分
+    if (y < 0) {
+      if (y <= -64)
+        return;
+      bits >>= -y;
+      y = 0;
+    }
+    if (y >= Height())
+      return;
+
+    uint8_t page = y >> 3;
+    const uint8_t shift = y & 7;
+    uint8_t *dst = buffer_.data() + page * WIDTH + x;
+    ApplyByte(dst, static_cast<uint8_t>(bits << shift), color);
+    bits >>= 8 - shift;
+    while (bits && ++page < PAGES) {
+      dst += WIDTH;
+      ApplyByte(dst, static_cast<uint8_t>(bits), color);
+      bits >>= 8;
+    }
+  }
+
+  /// @brief 获取放大后的字模列, 2-4倍取编译期缓存
+  static uint64_t ScaledGlyphColumn(size_t index, uint8_t size) {
+    switch (size) {
+    case 2:
+      return fonts::SCALED_FONT_5X8<2>[index];
+    case 3:
+      return fonts::SCALED_FONT_5X8<3>[index];
+    case 4:
+      return fonts::SCALED_FONT_5X8<4>[index];
+    default:
+      return fonts::ScaleColumn(fonts::FONT_5X8[index], size);
+    }
+  }
+
+  /// @brief 发送一帧中与屏幕镜像不同的区间, 调用方需持有flush_mutex_
+  /// @param frame 待发送的帧
+  void FlushFrame(const uint8_t *frame) {
+    // 检查传输层是否有效
+    if (!IsOpen())
+      return;
+
+    flush_stats_.frames++;
+
+    FrameSegment segments[PAGES];
+    size_t dirty_pages = 0;
+
+    // 逐页比较并记录变化区间
+    for (uint8_t page = 0; page < PAGES; page++) {
+      uint16_t first, last;
+      if (!FindDirtyColumns(frame, page, first, last))
+        continue;
+      segments[dirty_pages++] = {page, static_cast<uint8_t>(first + COL_OFFSET),
+                                 static_cast<uint8_t>(last + COL_OFFSET),
+                                 frame + page * WIDTH + first};
+    }
+
+    if (dirty_pages == 0) {
+      flush_stats_.skipped_frames++;
+      return;
+    }
+
+    // 发送变化区间, 成功后同步镜像
+    if (!transport_->SendFrame(segments, dirty_pages)) {
+      std::cerr << "写入显示数据失败" << std::endl;
+      shadow_valid_ = false;
+      return;
+    }
+    for (size_t i = 0; i < dirty_pages; i++) {
+      const FrameSegment &seg = segments[i];
+      const size_t offset = seg.page * WIDTH + seg.first_col - COL_OFFSET;
+      std::memcpy(shadow_.data() + offset, frame + offset,
+                  seg.last_col - seg.first_col + 1);
+    }
+    flush_stats_.pages_sent += dirty_pages;
+    shadow_valid_ = true;
+  }
+
+  /// @brief 刷新线程: 取最新提交的帧发送, 期间渲染线程可继续提交
+  void AsyncFlushLoop() {
+    std::unique_lock<std::mutex> lock(async_->mutex);
+    while (true) {
+      async_->submitted.wait(
+          lock, [this] { return async_->pending_ready || async_->stop; });
+      if (!async_->pending_ready)
+        break; // 已停止且没有待发送的帧
+
+      std::swap(async_->pending, async_->flushing);
+      async_->pending_ready = false;
+      async_->busy = true;
+      lock.unlock();
+      {
+        std::lock_guard<std::mutex> flush_lock(flush_mutex_);
+        FlushFrame(async_->flushing);
+      }
+      lock.lock();
+      async_->busy = false;
+      if (!async_->pending_ready)
+        async_->idle.notify_all();
+    }
+    async_->idle.notify_all();
+  }
+
+  /// @brief 接管另一个对象的全部状态, 调用方需保证本对象未启动异步刷新
+  /// @note 源对象不再持有传输层, IsOpen()返回false, 刷新与命令均为空操作
+  void MoveFrom(SSD1315Display &other) {
+    const bool was_async = other.IsAsyncFlush();
+    other.StopAsyncFlush();
+    transport_ = std::move(other.transport_);
+    buffer_ = other.buffer_;
+    shadow_ = other.shadow_;
+    shadow_valid_ = other.shadow_valid_;
+    flush_stats_ = other.flush_stats_;
+    if (was_async)
+      StartAsyncFlush();
   }
 
 public:
-  /// @brief 打开设备
+  /// @brief 打开I2C设备
   /// @param i2c_device
-  SSD1315Display(std::string i2c_device) : i2c_dev_path_(i2c_device) {
-    buffer_ = new uint8_t[SSD1315_BUFFER_SIZE];
+  explicit SSD1315Display(std::string i2c_device)
+      : SSD1315Display(std::make_unique<I2cTransport>(std::move(i2c_device),
+                                                      SSD1315_I2C_ADDRESS)) {}
+
+  /// @brief 使用指定传输层
+  /// @param transport
+  explicit SSD1315Display(std::unique_ptr<DisplayTransport> transport)
+      : transport_(std::move(transport)) {
     InitSSD1315();
   };
 
+  SSD1315Display(const SSD1315Display &) = delete;
+  SSD1315Display &operator=(const SSD1315Display &) = delete;
+
+  /// @brief 移动构造, 源对象的异步刷新线程会迁移到新对象
+  SSD1315Display(SSD1315Display &&other) noexcept { MoveFrom(other); }
+
+  SSD1315Display &operator=(SSD1315Display &&other) noexcept {
+    if (this != &other) {
+      StopAsyncFlush();
+      MoveFrom(other);
+    }
+    return *this;
+  }
+
+  /// @brief 传输层是否可用(被移动后的对象返回false)
+  bool IsOpen() const { return transport_ && transport_->IsOpen(); }
+
   /// @brief 初始化
   bool InitSSD1315() {
-    // 打开设备
-    i2c_fd_ = open(i2c_dev_path_.c_str(), O_RDWR);
-    // 设置从设备地址
-    ioctl(i2c_fd_, I2C_SLAVE, SSD1315_I2C_ADDRESS);
-
     // 初始化命令队列
     const uint8_t init_sequence[] = {
-        0xAE,       // 关闭显示
-        0xD5, 0x80, // 设置显示时钟分频比/振荡器频率
-        0xA8, 0x3F, // 设置复用率(1/64)
-        0xD3, 0x00, // 设置显示偏移
-        0x40,       // 设置显示起始行
-        0x8D, 0x14, // 启用电荷泵
-        0x20, 0x00, // 设置内存地址模式为水平模式
-        0xA1,       // 段重映射(0xA1正常,0xA0镜像)
-        0xC8,       // COM输出扫描方向(0xC8正常,0xC0镜像)
-        0xDA, 0x12, // 设置COM管脚配置
-        0x81, 0xCF, // 设置对比度控制
-        0xD9, 0xF1, // 设置预充电周期
-        0xDB, 0x40, // 设置VCOMH电平
-        0xA4,       // 整个显示开启(无背景)
-        0xA6,       // 正常显示(非反色)
-        0xAF        // 开启显示
+        0xAE,           // 关闭显示
+        0xD5, 0x80,     // 设置显示时钟分频比/振荡器频率
+        0xA8, H - 1,    // 设置复用率(1/H)
+        0xD3, 0x00,     // 设置显示偏移
+        0x40,           // 设置显示起始行
+        0x8D, 0x14,     // 启用电荷泵
+        0x20, 0x00,     // 设置内存地址模式为水平模式
+        0xA1,           // 段重映射(0xA1正常,0xA0镜像)
+        0xC8,           // COM输出扫描方向(0xC8正常,0xC0镜像)
+        0xDA, COM_PINS, // 设置COM管脚配置
+        0x81, 0xCF,     // 设置对比度控制
+        0xD9, 0xF1,     // 设置预充电周期
+        0xDB, 0x40,     // 设置VCOMH电平
+        0xA4,           // 整个显示开启(无背景)
+        0xA6,           // 正常显示(非反色)
+        0xAF            // 开启显示
     };
 
-    // 发送初始化命令
-    for (uint8_t cmd : init_sequence) {
-      if (!SendCommand(cmd))
-        return false;
-    }
+    // 一次性发送初始化命令
+    if (!SendCommands(init_sequence, sizeof(init_sequence)))
+      return false;
+    // 屏幕内容未知, 下一帧需整屏发送
+    InvalidateDisplay();
     return true;
   }
 
   /// @brief 下发命令
   /// @param command
   /// @return
-  bool SendCommand(uint8_t command) {
-    uint8_t packet[2] = {0x00, command}; // Co=0, D/C=0(命令模式)
-    if (write(i2c_fd_, packet, 2) != 2) {
-      std::cerr << "发送命令失败: 0x" << std::hex << (int)command << std::endl;
-      return false;
-    }
-    return true;
+  bool SendCommand(uint8_t command) { return SendCommands(&command, 1); }
+
+  /// @brief 以单个控制字节前缀批量下发命令
+  /// @param commands 命令序列
+  /// @param len 命令字节数(不超过32)
+  /// @return
+  bool SendCommands(const uint8_t *commands, size_t len) {
+    std::lock_guard<std::mutex> lock(flush_mutex_);
+    return transport_ && transport_->SendCommands(commands, len);
   }
 
   /// @brief 清屏
-  void ClearDisplay() { std::memset(buffer_, 0, SSD1315_BUFFER_SIZE); }
+  void ClearDisplay() { buffer_.fill(0); }
 
-  /// @brief 刷新显示
+  /// @brief 刷新显示, 仅发送与屏幕镜像相比发生变化的页和列区间
+  /// @note 异步模式下仅把当前帧交给刷新线程, 不等待总线传输
   void RefreshDisplay() {
-    // 检查I2C文件是否有效
-    if (i2c_fd_ < 0)
+    if (!async_) {
+      std::lock_guard<std::mutex> lock(flush_mutex_);
+      FlushFrame(buffer_.data());
       return;
+    }
 
-    // 逐页发送数据
-    for (uint8_t page = 0; page < SSD1315_PAGES; page++) {
-      SetPageAddress(page); // 设置当前页
-      SetColumnAddress(0);  // 设置列起始地址
+    {
+      std::lock_guard<std::mutex> lock(async_->mutex);
+      // 上一帧还未被取走时直接覆盖, 只发送最新帧
+      if (async_->pending_ready)
+        async_->coalesced++;
+      std::memcpy(async_->pending, buffer_.data(), BUFFER_SIZE);
+      async_->pending_ready = true;
+    }
+    async_->submitted.notify_one();
+  };
 
-      uint8_t packet[SSD1315_WIDTH + 1];
-      packet[0] = 0x40; // 数据模式控制字节
+  /// @brief 启动异步刷新线程
+  void StartAsyncFlush() {
+    if (async_)
+      return;
+    async_ = std::make_unique<AsyncFlush>();
+    async_->worker = std::thread([this] { AsyncFlushLoop(); });
+  }
 
-      // 从缓冲区复制当前页的数据
-      std::memcpy(packet + 1, buffer_ + (page * SSD1315_WIDTH), SSD1315_WIDTH);
+  /// @brief 停止异步刷新线程, 退出前发送最后提交的帧
+  void StopAsyncFlush() {
+    if (!async_)
+      return;
+    {
+      std::lock_guard<std::mutex> lock(async_->mutex);
+      async_->stop = true;
+    }
+    async_->submitted.notify_one();
+    if (async_->worker.joinable())
+      async_->worker.join();
+    async_.reset();
+  }
 
-      // 写入I2C数据
-      if (write(i2c_fd_, packet, SSD1315_WIDTH + 1) != SSD1315_WIDTH + 1) {
-        std::cerr << "写入I2C数据失败" << std::endl;
-      }
+  /// @brief 是否处于异步刷新模式
+  bool IsAsyncFlush() const { return async_ != nullptr; }
+
+  /// @brief 等待已提交的帧全部发送完毕
+  void WaitForFlush() {
+    if (!async_)
+      return;
+    std::unique_lock<std::mutex> lock(async_->mutex);
+    async_->idle.wait(lock,
+                      [this] { return !async_->pending_ready && !async_->busy; });
+  }
+
+  /// @brief 使屏幕镜像失效, 下一次刷新发送整屏
+  void InvalidateDisplay() {
+    std::lock_guard<std::mutex> lock(flush_mutex_);
+    shadow_valid_ = false;
+  }
+
+  /// @brief 获取刷新统计(字节数与系统调用数来自传输层)
+  DisplayFlushStats FlushStats() {
+    std::lock_guard<std::mutex> lock(flush_mutex_);
+    DisplayFlushStats stats = flush_stats_;
+    if (transport_) {
+      stats.bytes_sent = transport_->Stats().bytes_sent;
+      stats.syscalls = transport_->Stats().syscalls;
     }
-  };
+    if (async_) {
+      std::lock_guard<std::mutex> async_lock(async_->mutex);
+      stats.coalesced_frames = async_->coalesced;
+    }
+    return stats;
+  }
+
+  /// @brief 清零刷新统计
+  void ResetFlushStats() {
+    std::lock_guard<std::mutex> lock(flush_mutex_);
+    flush_stats_ = DisplayFlushStats{};
+    if (transport_)
+      transport_->ResetStats();
+    if (async_) {
+      std::lock_guard<std::mutex> async_lock(async_->mutex);
+      async_->coalesced = 0;
+    }
+  }
+
+  /// @brief 获取传输层, 仅在IsOpen()为true时调用
+  DisplayTransport &Transport() { return *transport_; }
+
+  /// @brief 获取显示缓冲区(页优先布局)
+  const uint8_t *Buffer() const { return buffer_.data(); }
 
   /// @brief 获取屏幕宽度
   /// @return 屏幕宽度(像素)
-  int16_t Width() const { return SSD1315_WIDTH; }
+  static constexpr int16_t Width() { return W; }
 
   /// @brief 获取屏幕高度
   /// @return 屏幕高度(像素)
-  int16_t Height() const { return SSD1315_HEIGHT; }
+  static constexpr int16_t Height() { return H; }
 
   /// @brief 绘制ASCII字符
   /// @brief 填充整个显示缓冲区
   /// @param color 填充颜色: 0-黑色, 1-白色
   void FillDisplay(uint8_t color = 0) {
-    std::memset(buffer_, color ? 0xFF : 0x00, SSD1315_BUFFER_SIZE);
+    buffer_.fill(color ? 0xFF : 0x00);
   }
 
   /// @brief 绘制单个像素点
@@ -147,7 +469,7 @@ public:
       return;
 
     // 计算像素在显存中的位置
-    uint16_t byte_index = x + (y / 8) * SSD1315_WIDTH;
+    uint16_t byte_index = x + (y / 8) * WIDTH;
     uint8_t bit_mask = 1 << (y & 7); // 计算位位置
 
     // 根据颜色设置像素
@@ -171,6 +493,16 @@ public:
   /// @param y1 终点Y坐标
   /// @param color 线条颜色
   void DrawLine(int16_t x0, int16_t y0, int16_t x1, int16_t y1, uint8_t color) {
+    // 水平/垂直线走按页填充路径
+    if (y0 == y1) {
+      DrawFastHLine(std::min(x0, x1), y0, std::abs(x1 - x0) + 1, color);
+      return;
+    }
+    if (x0 == x1) {
+      DrawFastVLine(x0, std::min(y0, y1), std::abs(y1 - y0) + 1, color);
+      return;
+    }
+
     int16_t dx = std::abs(x1 - x0);
     int16_t sx = x0 < x1 ? 1 : -1;
     int16_t dy = -std::abs(y1 - y0);
@@ -194,6 +526,24 @@ public:
     }
   }
 
+  /// @brief 绘制水平线
+  /// @param x 起点X坐标
+  /// @param y Y坐标
+  /// @param w 长度
+  /// @param color 线条颜色
+  void DrawFastHLine(int16_t x, int16_t y, int16_t w, uint8_t color) {
+    FillRect(x, y, w, 1, color);
+  }
+
+  /// @brief 绘制垂直线
+  /// @param x X坐标
+  /// @param y 起点Y坐标
+  /// @param h 长度
+  /// @param color 线条颜色
+  void DrawFastVLine(int16_t x, int16_t y, int16_t h, uint8_t color) {
+    FillRect(x, y, 1, h, color);
+  }
+
   /// @brief 绘制矩形边框
   /// @param x 左上角X坐标
   /// @param y 左上角Y坐标
@@ -201,33 +551,126 @@ public:
   /// @param h 高度
   /// @param color 边框颜色
   void DrawRect(int16_t x, int16_t y, int16_t w, int16_t h, uint8_t color) {
+    if (w <= 0 || h <= 0)
+      return;
+
     // 绘制上下边框
-    for (int16_t i = x; i < x + w; i++) {
-      DrawPixel(i, y, color);         // 上边框
-      DrawPixel(i, y + h - 1, color); // 下边框
+    DrawFastHLine(x, y, w, color);
+    if (h > 1)
+      DrawFastHLine(x, y + h - 1, w, color);
+
+    // 绘制左右边框(不含已绘制的角点)
+    DrawFastVLine(x, y + 1, h - 2, color);
+    if (w > 1)
+      DrawFastVLine(x + w - 1, y + 1, h - 2, color);
+  }
+
+  /// @brief 绘制填充矩形, 裁剪后按页掩码整字节填充
+  /// @param x 左上角X坐标
+  /// @param y 左上角Y坐标
+  /// @param w 宽度
+  /// @param h 高度
+  /// @param color 填充颜色
+  void FillRect(int16_t x, int16_t y, int16_t w, int16_t h, uint8_t color) {
+    // 一次性裁剪到屏幕范围
+    int16_t x0 = std::max<int16_t>(x, 0);
+    int16_t y0 = std::max<int16_t>(y, 0);
+    int16_t x1 = std::min<int16_t>(x + w, Width());
+    int16_t y1 = std::min<int16_t>(y + h, Height());
+    if (x0 >= x1 || y0 >= y1)
+      return;
+
+    const uint8_t first_page = y0 >> 3;
+    const uint8_t last_page = (y1 - 1) >> 3;
+    for (uint8_t page = first_page; page <= last_page; page++) {
+      uint8_t mask = 0xFF;
+      if (page == first_page)
+        mask &= 0xFF << (y0 & 7);
+      if (page == last_page)
+        mask &= 0xFF >> (7 - ((y1 - 1) & 7));
+      FillSpan(buffer_.data() + page * WIDTH + x0, x1 - x0, mask, color);
     }
+  }
 
-    // 绘制左右边框
-    for (int16_t i = y; i < y + h; i++) {
-      DrawPixel(x, i, color);         // 左边框
-      DrawPixel(x + w - 1, i, color); // 右边框
+  /// @brief 从同尺寸的帧缓冲区拷贝矩形区域(如恢复背景)
+  /// @param src 源帧缓冲区
+  /// @param x 左上角X坐标
+  /// @param y 左上角Y坐标
+  /// @param w 宽度
+  /// @param h 高度
+  void CopyRect(const FrameBuffer &src, int16_t x, int16_t y, int16_t w,
+                int16_t h) {
+    int16_t x0 = std::max<int16_t>(x, 0);
+    int16_t y0 = std::max<int16_t>(y, 0);
+    int16_t x1 = std::min<int16_t>(x + w, Width());
+    int16_t y1 = std::min<int16_t>(y + h, Height());
+    if (x0 >= x1 || y0 >= y1)
+      return;
+
+    const uint8_t first_page = y0 >> 3;
+    const uint8_t last_page = (y1 - 1) >> 3;
+    for (uint8_t page = first_page; page <= last_page; page++) {
+      uint8_t mask = 0xFF;
+      if (page == first_page)
+        mask &= 0xFF << (y0 & 7);
+      if (page == last_page)
+        mask &= 0xFF >> (7 - ((y1 - 1) & 7));
+      const size_t offset = page * WIDTH + x0;
+      if (mask == 0xFF) {
+        std::memcpy(buffer_.data() + offset, src.data() + offset, x1 - x0);
+        continue;
+      }
+      for (int16_t i = 0; i < x1 - x0; i++) {
+        uint8_t &dst = buffer_[offset + i];
+        dst = (dst & ~mask) | (src[offset + i] & mask);
+      }
     }
   }
 
-  /// @brief 绘制填充矩形
+  /// @brief 将矩形区域内容左移dx列, 右侧空出的列清零(用于滚动图表)
+  /// @note 完整的页每页一次memmove, 首尾不完整的页按掩码逐字节移动
   /// @param x 左上角X坐标
   /// @param y 左上角Y坐标
   /// @param w 宽度
   /// @param h 高度
-  /// @param color 填充颜色
-  void FillRect(int16_t x, int16_t y, int16_t w, int16_t h, uint8_t color) {
-    for (int16_t i = y; i < y + h; i++) {
-      for (int16_t j = x; j < x + w; j++) {
-        DrawPixel(j, i, color);
+  /// @param dx 左移的列数
+  void ScrollRectLeft(int16_t x, int16_t y, int16_t w, int16_t h, int16_t dx) {
+    int16_t x0 = std::max<int16_t>(x, 0);
+    int16_t y0 = std::max<int16_t>(y, 0);
+    int16_t x1 = std::min<int16_t>(x + w, Width());
+    int16_t y1 = std::min<int16_t>(y + h, Height());
+    if (x0 >= x1 || y0 >= y1 || dx <= 0)
+      return;
+    if (dx >= x1 - x0) {
+      FillRect(x0, y0, x1 - x0, y1 - y0, 0);
+      return;
+    }
+
+    const int16_t keep = x1 - x0 - dx; // 保留的列数
+    const uint8_t first_page = y0 >> 3;
+    const uint8_t last_page = (y1 - 1) >> 3;
+    for (uint8_t page = first_page; page <= last_page; page++) {
+      uint8_t mask = 0xFF;
+      if (page == first_page)
+        mask &= 0xFF << (y0 & 7);
+      if (page == last_page)
+        mask &= 0xFF >> (7 - ((y1 - 1) & 7));
+      uint8_t *row = buffer_.data() + page * WIDTH + x0;
+      if (mask == 0xFF) {
+        std::memmove(row, row + dx, keep);
+        std::memset(row + keep, 0x00, dx);
+        continue;
       }
+      for (int16_t i = 0; i < keep; i++)
+        row[i] = (row[i] & ~mask) | (row[i + dx] & mask);
+      for (int16_t i = keep; i < x1 - x0; i++)
+        row[i] &= ~mask;
     }
   }
 
+  /// @brief 保存当前帧缓冲区
+  void SaveBuffer(FrameBuffer &dst) const { dst = buffer_; }
+
   /// @brief 绘制ASCII字符
   /// @param x 字符左上角X坐标
   /// @param y 字符左上角Y坐标
@@ -242,29 +685,33 @@ public:
       return;
 
     // 替换无效字符为问号
-    if (c < 32 || c > 126)
+    if (c < fonts::FONT_5X8_FIRST || c > fonts::FONT_5X8_LAST)
       c = '?';
+    const size_t glyph = (c - fonts::FONT_5X8_FIRST) * fonts::FONT_5X8_COLS;
 
-    // 绘制字符点阵
-    for (int8_t col = 0; col < 6; col++) {
-      uint8_t line_data;
-      if (col == 5) {
-        line_data = 0x00; // 最后一列为空
-      } else {
-        // 获取字体数据
-        line_data = fonts::FONT_5X8[(c - 32) * 5 + col];
+    // 原始大小: 字模列直接写入显存(第6列为空白, 无需绘制)
+    if (size == 1) {
+      for (uint8_t col = 0; col < fonts::FONT_5X8_COLS; col++)
+        BlitColumn(x + col, y, fonts::FONT_5X8[glyph + col], color);
+      return;
+    }
+
+    // 放大字符: 放大后的列在横向重复size次
+    if (size <= 8) {
+      for (uint8_t col = 0; col < fonts::FONT_5X8_COLS; col++) {
+        const uint64_t bits = ScaledGlyphColumn(glyph + col, size);
+        for (uint8_t k = 0; k < size; k++)
+          BlitColumn(x + col * size + k, y, bits, color);
       }
+      return;
+    }
 
-      // 绘制当前列的点阵数据
+    // 超过8倍时逐点放大
+    for (int8_t col = 0; col < fonts::FONT_5X8_COLS; col++) {
+      uint8_t line_data = fonts::FONT_5X8[glyph + col];
       for (int8_t row = 0; row < 8; row++) {
-        if (line_data & 0x1) { // 当前位是否置位
-          if (size == 1) {
-            DrawPixel(x + col, y + row, color);
-          } else {
-            // 放大字符
-            FillRect(x + col * size, y + row * size, size, size, color);
-          }
-        }
+        if (line_data & 0x1)
+          FillRect(x + col * size, y + row * size, size, size, color);
         line_data >>= 1; // 移至下一个位
       }
     }
@@ -293,8 +740,8 @@ public:
   /// @brief 设置OLED对比度
   /// @param contrast 对比度值(0-255)
   void SetContrast(uint8_t contrast) {
-    SendCommand(0x81);     // 设置对比度命令
-    SendCommand(contrast); // 对比度值
+    const uint8_t commands[] = {0x81, contrast}; // 设置对比度命令 + 对比度值
+    SendCommands(commands, sizeof(commands));
   }
 
   /// @brief 绘制圆形
@@ -323,10 +770,8 @@ public:
   void FillCircle(int16_t x0, int16_t y0, int16_t r, uint8_t color) {
     int16_t x = -r, y = 0, err = 2 - 2 * r;
     do {
-      for (int16_t i = x0 + x; i <= x0 - x; i++) {
-        DrawPixel(i, y0 + y, color);
-        DrawPixel(i, y0 - y, color);
-      }
+      DrawFastHLine(x0 + x, y0 + y, 1 - 2 * x, color);
+      DrawFastHLine(x0 + x, y0 - y, 1 - 2 * x, color);
       r = err;
       if (r <= y) err += ++y * 2 + 1;
       if (r > x || err > y) err += ++x * 2 + 1;
@@ -365,10 +810,10 @@ public:
   /// @param color 颜色
   void DrawRoundRect(int16_t x, int16_t y, int16_t w, int16_t h, 
                      int16_t r, uint8_t color) {
-    DrawLine(x + r, y, x + w - r - 1, y, color);
-    DrawLine(x + r, y + h - 1, x + w - r - 1, y + h - 1, color);
-    DrawLine(x, y + r, x, y + h - r - 1, color);
-    DrawLine(x + w - 1, y + r, x + w - 1, y + h - r - 1, color);
+    DrawFastHLine(x + r, y, w - 2 * r, color);
+    DrawFastHLine(x + r, y + h - 1, w - 2 * r, color);
+    DrawFastVLine(x, y + r, h - 2 * r, color);
+    DrawFastVLine(x + w - 1, y + r, h - 2 * r, color);
     
     DrawCircleHelper(x + r, y + r, r, 1, color);
     DrawCircleHelper(x + w - r - 1, y + r, r, 2, color);
@@ -450,30 +895,28 @@ public:
       f += ddF_x;
 
       if (cornername & 0x1) {
-        DrawLine(x0 - x, y0 + y, x0 - x, y0 + y - delta, color);
-        DrawLine(x0 - y, y0 + x, x0 - y, y0 + x - delta, color);
+        DrawFastVLine(x0 - x, y0 + y - delta, delta + 1, color);
+        DrawFastVLine(x0 - y, y0 + x - delta, delta + 1, color);
       }
       if (cornername & 0x2) {
-        DrawLine(x0 + x, y0 + y, x0 + x, y0 + y - delta, color);
-        DrawLine(x0 + y, y0 + x, x0 + y, y0 + x - delta, color);
+        DrawFastVLine(x0 + x, y0 + y - delta, delta + 1, color);
+        DrawFastVLine(x0 + y, y0 + x - delta, delta + 1, color);
       }
       if (cornername & 0x4) {
-        DrawLine(x0 - x, y0 - y + delta, x0 - x, y0 - y, color);
-        DrawLine(x0 - y, y0 - x + delta, x0 - y, y0 - x, color);
+        DrawFastVLine(x0 - x, y0 - y, delta + 1, color);
+        DrawFastVLine(x0 - y, y0 - x, delta + 1, color);
       }
       if (cornername & 0x8) {
-        DrawLine(x0 + x, y0 - y + delta, x0 + x, y0 - y, color);
-        DrawLine(x0 + y, y0 - x + delta, x0 + y, y0 - x, color);
+        DrawFastVLine(x0 + x, y0 - y, delta + 1, color);
+        DrawFastVLine(x0 + y, y0 - x, delta + 1, color);
       }
     }
   }
 
-  ~SSD1315Display() {
-    // 释放显存缓冲区
-    delete[] buffer_;
-    // 关闭I2C设备
-    if (i2c_fd_ >= 0) {
-      close(i2c_fd_);
-    }
-  };
+  ~SSD1315Display() { StopAsyncFlush(); };
 };
+
+using SSD1315Display128x64 = SSD1315Display<128, 64>;
+using SSD1315Display128x32 = SSD1315Display<128, 32>;
+using SSD1315Display72x40 = SSD1315Display<72, 40>;
+using SSD1315Display64x48 = SSD1315Display<64, 48>;
@@ -1,13 +1,137 @@
 #pragma once
+#include "../system_monitor/metric_history.hpp"
 #include "../system_monitor/system_monitor.hpp"
 #include "ssd1315_display.hpp"
+#include "ui_widgets.hpp"
+#include <array>
 #include <iomanip>
+#include <memory>
+
+/// @brief 页面标识
+enum class UiPage {
+  NONE,
+  WELCOME,
+  DEV_TEMP,
+  USAGE,
+  NET_INFOS,
+  SYSTEM_TIME,
+  NET_TRAFFIC,
+  SYSTEM_INFO,
+  CPU_TEMP_HISTORY,
+  NET_HISTORY,
+  DISK,
+};
 
 class UiManager {
 private:
-  SSD1315Display ssd1315_display_;
+  SSD1315Display128x64 &ssd1315_display_;
   uint8_t animation_frame_ = 0;
 
+  // 保留模式状态: 当前页面的静态背景与动态控件
+  UiPage active_page_ = UiPage::NONE;
+  int active_variant_ = 0;                         // 同一页面的不同布局
+  UiDisplay::FrameBuffer background_{};            // 静态背景快照
+  std::vector<std::unique_ptr<UiWidget>> widgets_; // 当前页面的控件
+  uint64_t widget_redraws_ = 0;                    // 控件重绘次数
+  bool page_entered_ = false;                      // 页面重建后尚未刷新
+  uint64_t widget_increments_ = 0;                 // 控件增量更新次数
+  size_t disk_page_entries_ = 0; // 进入磁盘页的次数, 用于轮换分页
+
+  // 趋势页: 从历史缓冲区增量读取样本
+  static constexpr int16_t GRAPH_WIDTH = 124;         // 趋势图宽度(列)
+  uint64_t history_cursor_ = 0;                       // 已绘制到的历史位置
+  std::array<MetricSample, GRAPH_WIDTH> history_buf_; // 读取缓冲
+
+  /// @brief 进入页面, 页面或布局变化时清屏并重新绘制静态背景
+  /// @return 需要重建页面时返回true, 调用方随后绘制背景并添加控件
+  bool EnterPage(UiPage page, int variant = 0) {
+    if (page == active_page_ && variant == active_variant_)
+      return false;
+    active_page_ = page;
+    active_variant_ = variant;
+    widgets_.clear();
+    ssd1315_display_.ClearDisplay();
+    page_entered_ = true;
+    return true;
+  }
+
+  /// @brief 静态背景绘制完毕, 保存快照供控件恢复背景
+  void FinishBackground() { ssd1315_display_.SaveBuffer(background_); }
+
+  template <typename T, typename... Args> T &AddWidget(Args &&...args) {
+    widgets_.push_back(std::make_unique<T>(std::forward<Args>(args)...));
+    return static_cast<T &>(*widgets_.back());
+  }
+
+  template <typename T> T &Widget(size_t index) {
+    return static_cast<T &>(*widgets_[index]);
+  }
+
+  /// @brief 重绘变化的控件并刷新屏幕, 无变化时不刷新
+  void RenderWidgets() {
+    // 与变化控件重叠的控件也需重绘, 否则会被背景恢复擦除
+    bool changed = true;
+    while (changed) {
+      changed = false;
+      for (auto &dirty : widgets_) {
+        if (!dirty->Dirty())
+          continue;
+        for (auto &other : widgets_) {
+          if (!other->Dirty() && other->Overlaps(*dirty)) {
+            other->MarkDirty();
+            changed = true;
+          }
+        }
+      }
+    }
+
+    // 未变脏的控件尝试增量更新(如趋势图滚动), 不恢复背景
+    bool any_dirty = false;
+    for (auto &widget : widgets_) {
+      if (widget->Dirty()) {
+        widget->RestoreBackground(ssd1315_display_, background_);
+        any_dirty = true;
+      } else if (widget->DrawIncremental(ssd1315_display_)) {
+        widget_increments_++;
+        any_dirty = true;
+      }
+    }
+    // 页面刚重建时背景本身也需要发送
+    if (!any_dirty && !page_entered_)
+      return;
+
+    for (auto &widget : widgets_) {
+      if (!widget->Dirty())
+        continue;
+      widget->Draw(ssd1315_display_);
+      widget->ClearDirty();
+      widget_redraws_++;
+    }
+    page_entered_ = false;
+    ssd1315_display_.RefreshDisplay();
+  }
+
+  /// @brief 读取上次绘制后新增的历史样本
+  /// @param entered 页面刚重建时回填最近一屏的样本
+  /// @return 读取的样本数, 样本按时间顺序存放在history_buf_
+  size_t ReadHistory(const MetricHistory &history, bool entered) {
+    if (entered)
+      history_cursor_ =
+          history.Head() - std::min<uint64_t>(history.Size(), GRAPH_WIDTH);
+    return history.ReadSince(history_cursor_, history_buf_.data(),
+                             history_buf_.size());
+  }
+
+  /// @brief 绘制圆角边框, 可选标题与分隔线
+  void DrawFrame(const char *title = nullptr, int16_t title_x = 0) {
+    ssd1315_display_.DrawRoundRect(0, 0, ssd1315_display_.Width(),
+                                   ssd1315_display_.Height(), 3, 1);
+    if (title) {
+      ssd1315_display_.DrawString(title_x, 5, title, 1, 1);
+      ssd1315_display_.DrawLine(0, 15, 128, 15, 1);
+    }
+  }
+
   // 温度格式化 (保留1位小数 + 摄氏度符号)
   std::string FormatTemperatureC(double value) {
     std::ostringstream oss;
@@ -26,6 +150,17 @@ private:
     return result;
   }
 
+  // 紧凑容量格式化 (G/T单位, 用于磁盘列表)
+  std::string FormatSize(uint64_t bytes) {
+    const double gb = bytes / (1024.0 * 1024.0 * 1024.0);
+    std::ostringstream oss;
+    if (gb >= 1024)
+      oss << std::fixed << std::setprecision(1) << gb / 1024 << "T";
+    else
+      oss << std::fixed << std::setprecision(gb < 10 ? 1 : 0) << gb << "G";
+    return oss.str();
+  }
+
   // 存储容量格式化 (整数 + GB单位)
   std::string FormatStorageGB(double value) {
     std::ostringstream oss;
@@ -106,135 +241,149 @@ private:
 public:
   /// @brief 依赖构造
   /// @param ssd1315_display
-  UiManager(SSD1315Display &ssd1315_display)
+  UiManager(SSD1315Display128x64 &ssd1315_display)
       : ssd1315_display_(ssd1315_display){
 
         };
 
+  /// @brief 强制下一次绘制重建当前页面
+  void Invalidate() { active_page_ = UiPage::NONE; }
+
+  /// @brief 控件累计重绘次数
+  uint64_t WidgetRedraws() const { return widget_redraws_; }
+
+  /// @brief 控件累计增量更新次数
+  uint64_t WidgetIncrements() const { return widget_increments_; }
+
   /// @brief 绘制初始UI
   void CreateInitUi() {
-    // 清空显示缓冲区
-    ssd1315_display_.ClearDisplay();
-    // 绘制边框
-    ssd1315_display_.DrawRoundRect(0, 0, ssd1315_display_.Width(),
-                                   ssd1315_display_.Height(), 3, 1);
-    // 绘制欢迎标题
-    ssd1315_display_.DrawString(28, 10, "WELCOME", 1, 2);
-
-    // 绘制动画圆点
-    uint8_t offset = (animation_frame_ % 4) * 2;
-    for (int i = 0; i < 3; i++) {
-      uint8_t size = (i == offset / 2) ? 2 : 1;
-      ssd1315_display_.FillCircle(45 + i * 10 + offset, 55, size, 1);
+    enum { DOTS };
+    if (EnterPage(UiPage::WELCOME)) {
+      // 绘制边框
+      DrawFrame();
+      // 绘制欢迎标题
+      ssd1315_display_.DrawString(28, 10, "WELCOME", 1, 2);
+      // 绘制欢迎信息
+      ssd1315_display_.DrawString(15, 35, "ORANGE PI", 1, 1);
+      FinishBackground();
+
+      // 动画圆点
+      AddWidget<IconWidget>(43, 53, 31, 5, [](UiDisplay &display, int frame) {
+        uint8_t offset = frame * 2;
+        for (int i = 0; i < 3; i++) {
+          uint8_t size = (i == offset / 2) ? 2 : 1;
+          display.FillCircle(45 + i * 10 + offset, 55, size, 1);
+        }
+      });
     }
-    animation_frame_++;
 
-    // 绘制欢迎信息
-    ssd1315_display_.DrawString(15, 35, "ORANGE PI", 1, 1);
+    Widget<IconWidget>(DOTS).SetState(animation_frame_ % 4);
+    animation_frame_++;
 
-    // 刷新显示
-    ssd1315_display_.RefreshDisplay();
+    RenderWidgets();
   };
 
   /// @brief 绘制设备温度UI
   /// @param dev_temp
-  void DrawDevTempPage(DevTempInfo &dev_temp) {
-    // 清空显示缓冲区
-    ssd1315_display_.ClearDisplay();
+  void DrawDevTempPage(const DevTempInfo &dev_temp) {
+    enum { CPU, GPU, DDR, VE, CPU_BAR, GPU_BAR };
+    if (EnterPage(UiPage::DEV_TEMP)) {
+      // 圆角边框、居中标题与分隔线
+      DrawFrame("TEMP", (128 / 2) - (5 * 4 / 2));
+
+      // 温度图标与标签: 左上、右上、左下、右下
+      DrawTempIcon(8, 22, 1);
+      ssd1315_display_.DrawString(20, 22, "CPU:", 1, 1);
+      DrawTempIcon(70, 22, 1);
+      ssd1315_display_.DrawString(82, 22, "GPU:", 1, 1);
+      DrawTempIcon(8, 42, 1);
+      ssd1315_display_.DrawString(20, 42, "DDR:", 1, 1);
+      DrawTempIcon(70, 42, 1);
+      ssd1315_display_.DrawString(82, 42, "VE:", 1, 1);
+
+      // 进度条风格的温度指示边框
+      ssd1315_display_.DrawRect(4, 56, 58, 4, 1);
+      ssd1315_display_.DrawRect(66, 56, 58, 4, 1);
+      FinishBackground();
+
+      AddWidget<TextWidget>(45, 22, 6);
+      AddWidget<TextWidget>(105, 22, 6);
+      AddWidget<TextWidget>(45, 42, 6);
+      AddWidget<TextWidget>(105, 42, 6);
+      AddWidget<BarWidget>(5, 57, 56, 2);
+      AddWidget<BarWidget>(67, 57, 56, 2);
+    }
+
+    Widget<TextWidget>(CPU).SetText(FormatTemperatureC(dev_temp.cpu_t));
+    Widget<TextWidget>(GPU).SetText(FormatTemperatureC(dev_temp.gpu_t));
+    Widget<TextWidget>(DDR).SetText(FormatTemperatureC(dev_temp.ddr_t));
+    Widget<TextWidget>(VE).SetText(FormatTemperatureC(dev_temp.ve_t));
 
-    // 绘制圆角边框
-    ssd1315_display_.DrawRoundRect(0, 0, ssd1315_display_.Width(),
-                                   ssd1315_display_.Height(), 3, 1);
-    
-    // 居中显示标题
-    ssd1315_display_.DrawString((128 / 2) - (5 * 4 / 2), 5, "TEMP", 1, 1);
-    
-    // 绘制分隔线
-    ssd1315_display_.DrawLine(0, 15, 128, 15, 1);
-
-    // 绘制温度图标和值 - 左上区域
-    DrawTempIcon(8, 22, 1);
-    ssd1315_display_.DrawString(20, 22, "CPU:", 1, 1);
-    ssd1315_display_.DrawString(45, 22, FormatTemperatureC(dev_temp.cpu_t), 1, 1);
-
-    // 右上区域
-    DrawTempIcon(70, 22, 1);
-    ssd1315_display_.DrawString(82, 22, "GPU:", 1, 1);
-    ssd1315_display_.DrawString(105, 22, FormatTemperatureC(dev_temp.gpu_t), 1, 1);
-
-    // 左下区域
-    DrawTempIcon(8, 42, 1);
-    ssd1315_display_.DrawString(20, 42, "DDR:", 1, 1);
-    ssd1315_display_.DrawString(45, 42, FormatTemperatureC(dev_temp.ddr_t), 1, 1);
-
-    // 右下区域
-    DrawTempIcon(70, 42, 1);
-    ssd1315_display_.DrawString(82, 42, "VE:", 1, 1);
-    ssd1315_display_.DrawString(105, 42, FormatTemperatureC(dev_temp.ve_t), 1, 1);
-
-    // 绘制进度条风格的温度指示
     int cpu_temp_bar = static_cast<int>(dev_temp.cpu_t / 100.0 * 120);
     int gpu_temp_bar = static_cast<int>(dev_temp.gpu_t / 100.0 * 120);
-    
-    ssd1315_display_.DrawRect(4, 56, 58, 4, 1);
-    if (cpu_temp_bar > 0) ssd1315_display_.FillRect(5, 57, cpu_temp_bar/2, 2, 1);
-    
-    ssd1315_display_.DrawRect(66, 56, 58, 4, 1);
-    if (gpu_temp_bar > 0) ssd1315_display_.FillRect(67, 57, gpu_temp_bar/2, 2, 1);
+    Widget<BarWidget>(CPU_BAR).SetFill(cpu_temp_bar / 2);
+    Widget<BarWidget>(GPU_BAR).SetFill(gpu_temp_bar / 2);
 
-    ssd1315_display_.RefreshDisplay();
+    RenderWidgets();
   };
 
   /// @brief 绘制CPU使用率&内存&磁盘页面
   void DrawDevMemAndDiskAndCpuUsagePage(double cpu_usage, MemInfo mem_info,
-                                        DiskInfo &disk_info) {
-    // 清空显示缓冲区
-    ssd1315_display_.ClearDisplay();
-    // 绘制圆角边框
-    ssd1315_display_.DrawRoundRect(0, 0, ssd1315_display_.Width(),
-                                   ssd1315_display_.Height(), 3, 1);
-    // 居中显示标题
-    ssd1315_display_.DrawString((128 / 2) - (5 * 5 / 2), 5, "USAGE", 1, 1);
-    
-    // 绘制分隔线
-    ssd1315_display_.DrawLine(0, 15, 128, 15, 1);
-
-    // CPU使用率 - 带图标和进度条
-    DrawCpuIcon(8, 20, 1);
-    ssd1315_display_.DrawString(20, 20, "CPU:", 1, 1);
-    ssd1315_display_.DrawString(45, 20, FormatPercentage(cpu_usage), 1, 1);
-    ssd1315_display_.DrawProgressBar(8, 30, 112, 6, static_cast<uint8_t>(cpu_usage), 1);
-
-    // 内存使用率 - 带图标和进度条
-    DrawMemIcon(8, 40, 1);
-    ssd1315_display_.DrawString(20, 40, "MEM:", 1, 1);
-    std::string mem_str = FormatPercentage(mem_info.usage_percent) + " (" + 
+                                        const DiskInfo &disk_info) {
+    enum { CPU, CPU_BAR, MEM, MEM_BAR };
+    if (EnterPage(UiPage::USAGE)) {
+      DrawFrame("USAGE", (128 / 2) - (5 * 5 / 2));
+
+      // CPU使用率 - 图标、标签与进度条边框
+      DrawCpuIcon(8, 20, 1);
+      ssd1315_display_.DrawString(20, 20, "CPU:", 1, 1);
+      ssd1315_display_.DrawRect(8, 30, 112, 6, 1);
+
+      // 内存使用率 - 图标、标签与进度条边框
+      DrawMemIcon(8, 40, 1);
+      ssd1315_display_.DrawString(20, 40, "MEM:", 1, 1);
+      ssd1315_display_.DrawRect(8, 50, 112, 6, 1);
+      FinishBackground();
+
+      AddWidget<TextWidget>(45, 20, 6);
+      AddWidget<BarWidget>(9, 31, 110, 4);
+      AddWidget<TextWidget>(45, 40, 15);
+      AddWidget<BarWidget>(9, 51, 110, 4);
+    }
+
+    Widget<TextWidget>(CPU).SetText(FormatPercentage(cpu_usage));
+    Widget<BarWidget>(CPU_BAR).SetPercent(static_cast<uint8_t>(cpu_usage));
+
+    std::string mem_str = FormatPercentage(mem_info.usage_percent) + " (" +
                           FormatStorageGB(mem_info.used_mb / 1024) + "/" +
                           FormatStorageGB(mem_info.total_mb / 1024) + ")";
-    ssd1315_display_.DrawString(45, 40, mem_str.substr(0, 15), 1, 1);
-    ssd1315_display_.DrawProgressBar(8, 50, 112, 6, 
-                                      static_cast<uint8_t>(mem_info.usage_percent), 1);
+    Widget<TextWidget>(MEM).SetText(mem_str.substr(0, 15));
+    Widget<BarWidget>(MEM_BAR).SetPercent(
+        static_cast<uint8_t>(mem_info.usage_percent));
 
-    ssd1315_display_.RefreshDisplay();
+    RenderWidgets();
   };
 
   /// @brief 绘制网络信息页面
   /// @param net_infos 
-  void DrawNetInfosPage(std::vector<NetInfo> &net_infos) {
-    // 清空显示缓冲区
-    ssd1315_display_.ClearDisplay();
-    // 绘制圆角边框
-    ssd1315_display_.DrawRoundRect(0, 0, ssd1315_display_.Width(),
-                                   ssd1315_display_.Height(), 3, 1);
-    // 居中显示标题
-    ssd1315_display_.DrawString((128 / 2) - (5 * 3 / 2), 5, "NET", 1, 1);
-    
-    // 绘制分隔线
-    ssd1315_display_.DrawLine(0, 15, 128, 15, 1);
-    
-    // 绘制网络图标动画效果
-    uint8_t icon_y = (animation_frame_ % 2) == 0 ? 18 : 20;
-    DrawNetIcon(5, icon_y, 1);
+  void DrawNetInfosPage(const std::vector<NetInfo> &net_infos) {
+    enum { ICON, IFACE1, IP1, FAMILY1, IFACE2, IP2 };
+    if (EnterPage(UiPage::NET_INFOS)) {
+      DrawFrame("NET", (128 / 2) - (5 * 3 / 2));
+      FinishBackground();
+
+      // 网络图标动画(上下跳动)
+      AddWidget<IconWidget>(5, 18, 9, 11, [this](UiDisplay &, int frame) {
+        DrawNetIcon(5, frame == 0 ? 18 : 20, 1);
+      });
+      AddWidget<TextWidget>(20, 20, 8);
+      AddWidget<TextWidget>(20, 32, 15);
+      AddWidget<TextWidget>(100, 32, 4);
+      AddWidget<TextWidget>(20, 44, 8);
+      AddWidget<TextWidget>(20, 56, 15);
+    }
+
+    Widget<IconWidget>(ICON).SetState(animation_frame_ % 2);
     animation_frame_++;
 
     // 过滤掉回环接口
@@ -245,129 +394,249 @@ public:
       }
     }
 
-    // 显示第一个网络接口的信息
-    if (!filtered_infos.empty()) {
-      std::string iface_name = filtered_infos[0].interface_name;
-      if (iface_name.length() > 8) iface_name = iface_name.substr(0, 8);
-      
-      std::string ip = filtered_infos[0].ip;
-      if (ip.length() > 15) ip = ip.substr(0, 15);
-      
-      ssd1315_display_.DrawString(20, 20, iface_name, 1, 1);
-      ssd1315_display_.DrawString(20, 32, ip, 1, 1);
-      ssd1315_display_.DrawString(100, 32, filtered_infos[0].family, 1, 1);
-    }
-
-    // 显示第二个网络接口的信息（如果有）
-    if (filtered_infos.size() > 1) {
-      std::string iface_name2 = filtered_infos[1].interface_name;
-      if (iface_name2.length() > 8) iface_name2 = iface_name2.substr(0, 8);
-      
-      std::string ip2 = filtered_infos[1].ip;
-      if (ip2.length() > 15) ip2 = ip2.substr(0, 15);
-      
-      ssd1315_display_.DrawString(20, 44, iface_name2, 1, 1);
-      ssd1315_display_.DrawString(20, 56, ip2, 1, 1);
-    }
-
-    ssd1315_display_.RefreshDisplay();
+    // 显示前两个网络接口的信息, 第一个接口附带地址族
+    const NetInfo empty_info;
+    const NetInfo &first =
+        filtered_infos.size() > 0 ? filtered_infos[0] : empty_info;
+    const NetInfo &second =
+        filtered_infos.size() > 1 ? filtered_infos[1] : empty_info;
+    Widget<TextWidget>(IFACE1).SetText(first.interface_name.substr(0, 8));
+    Widget<TextWidget>(IP1).SetText(first.ip.substr(0, 15));
+    Widget<TextWidget>(FAMILY1).SetText(first.family);
+    Widget<TextWidget>(IFACE2).SetText(second.interface_name.substr(0, 8));
+    Widget<TextWidget>(IP2).SetText(second.ip.substr(0, 15));
+
+    RenderWidgets();
   };
 
   /// @brief 绘制系统时间页面
-  void DrawSystemTimePage(SystemTime &sys_time) {
-    ssd1315_display_.ClearDisplay();
-    ssd1315_display_.DrawRoundRect(0, 0, ssd1315_display_.Width(),
-                                   ssd1315_display_.Height(), 3, 1);
-    
-    // 显示时间（使用大小1的字体，避免超出屏幕）
-    std::string time_str = FormatTime(sys_time.hour, sys_time.minute, sys_time.second);
-    ssd1315_display_.DrawString(15, 15, time_str, 1, 1);
-    
-    // 显示日期
-    std::string date_str = FormatDate(sys_time.year, sys_time.month, sys_time.day);
-    ssd1315_display_.DrawString(15, 30, date_str, 1, 1);
-    
-    // 绘制动画时钟指针
+  void DrawSystemTimePage(const SystemTime &sys_time) {
+    enum { TIME, DATE, SECOND_HAND };
+    if (EnterPage(UiPage::SYSTEM_TIME)) {
+      DrawFrame();
+      FinishBackground();
+
+      // 时间（使用大小1的字体，避免超出屏幕）与日期
+      AddWidget<TextWidget>(15, 15, 8);
+      AddWidget<TextWidget>(15, 30, 10);
+      // 动画时钟指针
+      AddWidget<IconWidget>(64, 54, 31, 1, [](UiDisplay &display, int len) {
+        display.DrawLine(64, 54, 64 + len, 54, 1);
+      });
+    }
+
+    Widget<TextWidget>(TIME).SetText(
+        FormatTime(sys_time.hour, sys_time.minute, sys_time.second));
+    Widget<TextWidget>(DATE).SetText(
+        FormatDate(sys_time.year, sys_time.month, sys_time.day));
     uint8_t sec_hand = (sys_time.second * 60) / 60; // 限制指针长度为60像素
-    ssd1315_display_.DrawLine(64, 54, 64 + sec_hand/2, 54, 1);
-    
-    ssd1315_display_.RefreshDisplay();
+    Widget<IconWidget>(SECOND_HAND).SetState(sec_hand / 2);
+
+    RenderWidgets();
   }
 
   /// @brief 绘制网络流量页面
-  void DrawNetTrafficPage(std::vector<NetTraffic> &traffic) {
-    ssd1315_display_.ClearDisplay();
-    ssd1315_display_.DrawRoundRect(0, 0, ssd1315_display_.Width(),
-                                   ssd1315_display_.Height(), 3, 1);
-    
-    ssd1315_display_.DrawString((128 / 2) - (5 * 4 / 2), 5, "TRAFFIC", 1, 1);
-    ssd1315_display_.DrawLine(0, 15, 128, 15, 1);
-    
+  void DrawNetTrafficPage(const std::vector<NetTraffic> &traffic) {
+    enum { IFACE, RX, TX, RX_BAR, TX_BAR };
+
     // 过滤掉回环接口
-    NetTraffic *selected_traffic = nullptr;
+    const NetTraffic *selected_traffic = nullptr;
     for (auto &t : traffic) {
       if (t.interface_name != "lo") {
         selected_traffic = &t;
         break;
       }
     }
-    
+
+    // 有无可显示接口对应两种布局
+    if (EnterPage(UiPage::NET_TRAFFIC, selected_traffic ? 1 : 0)) {
+      DrawFrame("TRAFFIC", (128 / 2) - (5 * 4 / 2));
+      if (selected_traffic) {
+        DrawNetIcon(5, 20, 1);
+        // 流量指示条边框
+        ssd1315_display_.DrawRect(75, 36, 50, 5, 1);
+        ssd1315_display_.DrawRect(75, 49, 50, 5, 1);
+      }
+      FinishBackground();
+
+      if (selected_traffic) {
+        AddWidget<TextWidget>(20, 20, 8);
+        AddWidget<TextWidget>(8, 35, 14);
+        AddWidget<TextWidget>(8, 48, 14);
+        AddWidget<BarWidget>(76, 37, 48, 3);
+        AddWidget<BarWidget>(76, 50, 48, 3);
+      }
+    }
+
     // 显示第一个网络接口的流量
     if (selected_traffic) {
-      DrawNetIcon(5, 20, 1);
-      
-      std::string iface_name = selected_traffic->interface_name;
-      if (iface_name.length() > 8) iface_name = iface_name.substr(0, 8);
-      ssd1315_display_.DrawString(20, 20, iface_name, 1, 1);
-      
-      std::string rx_str = "RX: " + FormatMbps(selected_traffic->rx_mbps);
-      std::string tx_str = "TX: " + FormatMbps(selected_traffic->tx_mbps);
-      
-      ssd1315_display_.DrawString(8, 35, rx_str, 1, 1);
-      ssd1315_display_.DrawString(8, 48, tx_str, 1, 1);
-      
-      // 绘制流量指示条
+      Widget<TextWidget>(IFACE).SetText(
+          selected_traffic->interface_name.substr(0, 8));
+      Widget<TextWidget>(RX).SetText("RX: " +
+                                     FormatMbps(selected_traffic->rx_mbps));
+      Widget<TextWidget>(TX).SetText("TX: " +
+                                     FormatMbps(selected_traffic->tx_mbps));
+
+      // 流量指示条
       uint8_t rx_bar = static_cast<uint8_t>(selected_traffic->rx_mbps * 10);
       uint8_t tx_bar = static_cast<uint8_t>(selected_traffic->tx_mbps * 10);
       if (rx_bar > 50) rx_bar = 50;
       if (tx_bar > 50) tx_bar = 50;
-      
-      ssd1315_display_.DrawRect(75, 36, 50, 5, 1);
-      if (rx_bar > 0) ssd1315_display_.FillRect(76, 37, rx_bar, 3, 1);
-      
-      ssd1315_display_.DrawRect(75, 49, 50, 5, 1);
-      if (tx_bar > 0) ssd1315_display_.FillRect(76, 50, tx_bar, 3, 1);
+      Widget<BarWidget>(RX_BAR).SetFill(rx_bar);
+      Widget<BarWidget>(TX_BAR).SetFill(tx_bar);
     }
-    
-    ssd1315_display_.RefreshDisplay();
+
+    RenderWidgets();
   }
 
   /// @brief 绘制系统信息页面
-  void DrawSystemInfoPage(CpuFreqInfo &cpu_freq, SystemLoad &sys_load, 
+  void DrawSystemInfoPage(const CpuFreqInfo &cpu_freq, const SystemLoad &sys_load,
                           const std::string &uptime) {
-    ssd1315_display_.ClearDisplay();
-    ssd1315_display_.DrawRoundRect(0, 0, ssd1315_display_.Width(),
-                                   ssd1315_display_.Height(), 3, 1);
-    
-    ssd1315_display_.DrawString((128 / 2) - (5 * 4 / 2), 5, "SYSTEM", 1, 1);
-    ssd1315_display_.DrawLine(0, 15, 128, 15, 1);
-    
+    enum { FREQ, LOAD, UPTIME };
+    if (EnterPage(UiPage::SYSTEM_INFO)) {
+      DrawFrame("SYSTEM", (128 / 2) - (5 * 4 / 2));
+      DrawCpuIcon(5, 20, 1);
+      FinishBackground();
+
+      AddWidget<TextWidget>(20, 20, 12);
+      AddWidget<TextWidget>(8, 35, 7);
+      AddWidget<TextWidget>(8, 48, 20);
+    }
+
     // CPU频率
-    DrawCpuIcon(5, 20, 1);
     std::string freq_str = std::to_string(static_cast<int>(cpu_freq.current_mhz)) + "MHz";
     if (freq_str.length() > 12) freq_str = freq_str.substr(0, 12);
-    ssd1315_display_.DrawString(20, 20, freq_str, 1, 1);
-    
+    Widget<TextWidget>(FREQ).SetText(freq_str);
+
     // 系统负载
-    std::string load_str = "L: " + std::to_string(sys_load.load1).substr(0, 4);
-    ssd1315_display_.DrawString(8, 35, load_str, 1, 1);
-    
+    Widget<TextWidget>(LOAD).SetText("L: " +
+                                     std::to_string(sys_load.load1).substr(0, 4));
+
     // 运行时间
     std::string up_str = "UP: " + uptime;
     if (up_str.length() > 20) up_str = up_str.substr(0, 20);
-    ssd1315_display_.DrawString(8, 48, up_str, 1, 1);
-    
-    ssd1315_display_.RefreshDisplay();
+    Widget<TextWidget>(UPTIME).SetText(up_str);
+
+    RenderWidgets();
+  }
+
+  /// @brief 绘制CPU使用率与温度趋势页面
+  /// @param history 指标历史, 每次只读取新增的样本
+  void DrawCpuTempHistoryPage(const MetricHistory &history) {
+    enum { CPU, CPU_GRAPH, TEMP, TEMP_GRAPH };
+    const bool entered = EnterPage(UiPage::CPU_TEMP_HISTORY);
+    if (entered) {
+      DrawFrame();
+      ssd1315_display_.DrawString(4, 3, "CPU", 1, 1);
+      ssd1315_display_.DrawString(4, 34, "TEMP", 1, 1);
+      FinishBackground();
+
+      AddWidget<TextWidget>(34, 3, 6);
+      AddWidget<SparklineWidget>(2, 12, GRAPH_WIDTH, 20, 0, 100);
+      AddWidget<TextWidget>(34, 34, 6);
+      AddWidget<SparklineWidget>(2, 43, GRAPH_WIDTH, 19, 30, 90,
+                                 SparklineStyle::LINE);
+    }
+
+    const size_t count = ReadHistory(history, entered);
+    for (size_t i = 0; i < count; i++) {
+      Widget<SparklineWidget>(CPU_GRAPH).Push(history_buf_[i].cpu_usage);
+      Widget<SparklineWidget>(TEMP_GRAPH).Push(history_buf_[i].cpu_temp);
+    }
+    if (count > 0) {
+      const MetricSample &latest = history_buf_[count - 1];
+      Widget<TextWidget>(CPU).SetText(FormatPercentage(latest.cpu_usage));
+      Widget<TextWidget>(TEMP).SetText(FormatTemperatureC(latest.cpu_temp));
+    }
+
+    RenderWidgets();
+  }
+
+  /// @brief 绘制网络收发速率趋势页面, 纵轴随峰值自动缩放
+  /// @param history 指标历史, 每次只读取新增的样本
+  void DrawNetHistoryPage(const MetricHistory &history) {
+    enum { RX, RX_GRAPH, TX, TX_GRAPH };
+    const bool entered = EnterPage(UiPage::NET_HISTORY);
+    if (entered) {
+      DrawFrame();
+      ssd1315_display_.DrawString(4, 3, "RX", 1, 1);
+      ssd1315_display_.DrawString(4, 34, "TX", 1, 1);
+      FinishBackground();
+
+      AddWidget<TextWidget>(22, 3, 10);
+      AddWidget<SparklineWidget>(2, 12, GRAPH_WIDTH, 20, 0, 1)
+          .SetAutoScale(true);
+      AddWidget<TextWidget>(22, 34, 10);
+      AddWidget<SparklineWidget>(2, 43, GRAPH_WIDTH, 19, 0, 1)
+          .SetAutoScale(true);
+    }
+
+    const size_t count = ReadHistory(history, entered);
+    for (size_t i = 0; i < count; i++) {
+      Widget<SparklineWidget>(RX_GRAPH).Push(history_buf_[i].rx_mbps);
+      Widget<SparklineWidget>(TX_GRAPH).Push(history_buf_[i].tx_mbps);
+    }
+    if (count > 0) {
+      const MetricSample &latest = history_buf_[count - 1];
+      Widget<TextWidget>(RX).SetText(FormatMbps(latest.rx_mbps));
+      Widget<TextWidget>(TX).SetText(FormatMbps(latest.tx_mbps));
+    }
+
+    RenderWidgets();
+  }
+
+  /// @brief 绘制磁盘页面, 每屏3个挂载点, 挂载点较多时每次进入页面翻一页
+  /// @param disks 所有挂载点
+  void DrawDiskPage(const std::vector<DiskInfo> &disks) {
+    constexpr size_t PER_VIEW = 3;
+    enum { PAGER, ROWS };
+    enum { NAME, USAGE, BAR, ROW_WIDGETS };
+
+    const size_t views =
+        std::max<size_t>(1, (disks.size() + PER_VIEW - 1) / PER_VIEW);
+    if (active_page_ != UiPage::DISK)
+      disk_page_entries_++;
+    const size_t view = (disk_page_entries_ - 1) % views;
+    const size_t first = std::min(view * PER_VIEW, disks.size());
+    const size_t rows = std::min(PER_VIEW, disks.size() - first);
+
+    // 行数不同的分页对应不同布局
+    if (EnterPage(UiPage::DISK, static_cast<int>(view * PER_VIEW + rows))) {
+      DrawFrame("DISK", 4);
+      for (size_t row = 0; row < rows; row++)
+        ssd1315_display_.DrawRect(4, 26 + row * 14, 120, 5, 1);
+      FinishBackground();
+
+      AddWidget<TextWidget>(92, 5, 5);
+      for (size_t row = 0; row < rows; row++) {
+        const int16_t y = static_cast<int16_t>(18 + row * 14);
+        AddWidget<TextWidget>(4, y, 8);
+        AddWidget<TextWidget>(56, y, 11);
+        AddWidget<BarWidget>(5, y + 9, 118, 3);
+      }
+    }
+
+    Widget<TextWidget>(PAGER).SetText(std::to_string(view + 1) + "/" +
+                                      std::to_string(views));
+    for (size_t row = 0; row < rows; row++) {
+      const DiskInfo &disk = disks[first + row];
+      const size_t base = ROWS + row * ROW_WIDGETS;
+      Widget<TextWidget>(base + NAME).SetText(disk.mount_point.substr(0, 8));
+      if (disk.valid) {
+        std::string usage =
+            std::to_string(static_cast<int>(disk.usage_percent + 0.5)) + "% " +
+            FormatSize(disk.total_bytes - disk.available_bytes) + "/" +
+            FormatSize(disk.total_bytes);
+        Widget<TextWidget>(base + USAGE).SetText(usage.substr(0, 11));
+        Widget<BarWidget>(base + BAR).SetPercent(
+            static_cast<uint8_t>(disk.usage_percent));
+      } else {
+        Widget<TextWidget>(base + USAGE).SetText("--");
+        Widget<BarWidget>(base + BAR).SetFill(0);
+      }
+    }
+
+    RenderWidgets();
   }
 
   ~UiManager(){
@@ -0,0 +1,130 @@
+#pragma once
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <mutex>
+
+/// @brief UI调度配置
+struct UiSchedulerConfig {
+  uint32_t max_fps = 10;            // 数据变化时的最高刷新率
+  uint32_t idle_fps = 5;            // 动画页面的刷新率, 0表示不播放动画
+  uint32_t page_duration_ms = 1500; // 每个页面的显示时长
+  uint8_t page_count = 1;           // 轮播页面数
+};
+
+/// @brief 事件驱动的UI调度器
+/// @note 仅在数据变化、动画到期或翻页时安排重绘, 其余时间休眠
+class UiScheduler {
+public:
+  using Clock = std::chrono::steady_clock;
+
+  /// @brief 重绘原因(可组合)
+  enum Reason : uint32_t {
+    NONE = 0,
+    DATA_CHANGED = 1 << 0, // 绑定数据变化
+    ANIMATION = 1 << 1,    // 动画帧到期
+    PAGE_CHANGED = 1 << 2, // 翻页
+  };
+
+  /// @brief 调度统计
+  struct Stats {
+    uint64_t wakeups{0}; // Poll调用次数
+    uint64_t frames{0};  // 安排的重绘次数
+  };
+
+private:
+  UiSchedulerConfig config_;
+  uint8_t page_ = 0;
+  bool animated_ = false;  // 当前页面是否有动画
+  uint32_t pending_ = NONE; // 尚未处理的重绘原因
+  Clock::time_point next_page_;
+  Clock::time_point next_animation_;
+  Clock::time_point next_frame_allowed_; // 受最高帧率限制的下一帧时间
+  Stats stats_;
+
+  // 其他线程的唤醒请求
+  std::atomic<bool> woken_{false};
+  std::mutex wake_mutex_;
+  std::condition_variable wake_cv_;
+
+  static Clock::duration FramePeriod(uint32_t fps) {
+    return std::chrono::duration_cast<Clock::duration>(
+        std::chrono::microseconds(1000000 / std::max<uint32_t>(fps, 1)));
+  }
+
+public:
+  explicit UiScheduler(const UiSchedulerConfig &config,
+                       Clock::time_point now = Clock::now())
+      : config_(config), pending_(PAGE_CHANGED),
+        next_page_(now + std::chrono::milliseconds(config.page_duration_ms)),
+        next_animation_(now), next_frame_allowed_(now) {}
+
+  /// @brief 绑定数据发生变化
+  void NotifyDataChanged() { pending_ |= DATA_CHANGED; }
+
+  /// @brief 从其他线程通知数据变化并唤醒休眠中的调度循环(线程安全)
+  void Wake() {
+    {
+      std::lock_guard<std::mutex> lock(wake_mutex_);
+      woken_ = true;
+    }
+    wake_cv_.notify_all();
+  }
+
+  /// @brief 设置当前页面是否需要动画帧
+  void SetAnimated(bool animated) { animated_ = animated; }
+
+  /// @brief 当前页面序号
+  uint8_t CurrentPage() const { return page_; }
+
+  /// @brief 处理到期事件
+  /// @param now 当前时间
+  /// @return 需要立即重绘时返回重绘原因, 否则返回NONE
+  uint32_t Poll(Clock::time_point now = Clock::now()) {
+    stats_.wakeups++;
+    if (woken_.exchange(false))
+      pending_ |= DATA_CHANGED;
+
+    if (now >= next_page_) {
+      page_ = (page_ + 1) % std::max<uint8_t>(config_.page_count, 1);
+      next_page_ = now + std::chrono::milliseconds(config_.page_duration_ms);
+      next_animation_ = now;
+      pending_ |= PAGE_CHANGED;
+    }
+
+    if (animated_ && config_.idle_fps > 0 && now >= next_animation_) {
+      next_animation_ = now + FramePeriod(config_.idle_fps);
+      pending_ |= ANIMATION;
+    }
+
+    if (pending_ == NONE || now < next_frame_allowed_)
+      return NONE;
+
+    uint32_t reasons = pending_;
+    pending_ = NONE;
+    next_frame_allowed_ = now + FramePeriod(config_.max_fps);
+    stats_.frames++;
+    return reasons;
+  }
+
+  /// @brief 下一次需要唤醒的时间
+  Clock::time_point NextWakeup() const {
+    Clock::time_point wakeup = next_page_;
+    if (animated_ && config_.idle_fps > 0)
+      wakeup = std::min(wakeup, next_animation_);
+    if (pending_ != NONE)
+      wakeup = std::min(wakeup, next_frame_allowed_);
+    return wakeup;
+  }
+
+  /// @brief 休眠到下一个UI事件或指定截止时间(取较早者), Wake()可提前唤醒
+  void SleepUntilNextEvent(Clock::time_point deadline) {
+    std::unique_lock<std::mutex> lock(wake_mutex_);
+    wake_cv_.wait_until(lock, std::min(NextWakeup(), deadline),
+                        [this] { return woken_.load(); });
+  }
+
+  const Stats &GetStats() const { return stats_; }
+};
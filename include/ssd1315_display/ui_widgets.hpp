@@ -0,0 +1,246 @@
+#pragma once
+#include "ssd1315_display.hpp"
+#include <cmath>
+#include <functional>
+#include <string>
+#include <vector>
+
+using UiDisplay = SSD1315Display128x64;
+
+/// @brief 保留模式控件基类, 仅在绑定的值变化后重绘自身区域
+class UiWidget {
+protected:
+  int16_t x_, y_, w_, h_; // 控件占用的矩形区域
+  bool dirty_ = true;     // 是否需要重绘
+
+public:
+  UiWidget(int16_t x, int16_t y, int16_t w, int16_t h)
+      : x_(x), y_(y), w_(w), h_(h) {}
+  virtual ~UiWidget() = default;
+
+  /// @brief 在已恢复背景的区域内绘制控件
+  virtual void Draw(UiDisplay &display) = 0;
+
+  /// @brief 在不恢复背景的情况下增量更新控件(如滚动图表只画新列)
+  /// @return 修改了显存时返回true, 不支持增量更新的控件返回false
+  virtual bool DrawIncremental(UiDisplay &) { return false; }
+
+  bool Dirty() const { return dirty_; }
+  void MarkDirty() { dirty_ = true; }
+  void ClearDirty() { dirty_ = false; }
+
+  /// @brief 用背景恢复控件区域
+  void RestoreBackground(UiDisplay &display,
+                         const UiDisplay::FrameBuffer &background) const {
+    display.CopyRect(background, x_, y_, w_, h_);
+  }
+
+  /// @brief 两个控件区域是否重叠
+  bool Overlaps(const UiWidget &other) const {
+    return x_ < other.x_ + other.w_ && other.x_ < x_ + w_ &&
+           y_ < other.y_ + other.h_ && other.y_ < y_ + h_;
+  }
+};
+
+/// @brief 文本控件
+class TextWidget : public UiWidget {
+private:
+  std::string text_;
+  uint8_t size_;
+
+public:
+  /// @param max_chars 最多显示的字符数, 决定控件宽度
+  TextWidget(int16_t x, int16_t y, uint8_t max_chars, uint8_t size = 1)
+      : UiWidget(x, y, max_chars * 6 * size, 8 * size), size_(size) {}
+
+  void SetText(const std::string &text) {
+    if (text == text_)
+      return;
+    text_ = text;
+    dirty_ = true;
+  }
+
+  void Draw(UiDisplay &display) override {
+    display.DrawString(x_, y_, text_, 1, size_);
+  }
+};
+
+/// @brief 进度条填充控件(边框属于静态背景)
+class BarWidget : public UiWidget {
+private:
+  int16_t fill_ = 0; // 填充宽度(像素)
+
+public:
+  BarWidget(int16_t x, int16_t y, int16_t w, int16_t h) : UiWidget(x, y, w, h) {}
+
+  /// @brief 设置填充宽度(像素), 超出范围时截断
+  void SetFill(int16_t fill) {
+    fill = std::max<int16_t>(0, std::min<int16_t>(fill, w_));
+    if (fill == fill_)
+      return;
+    fill_ = fill;
+    dirty_ = true;
+  }
+
+  /// @brief 按百分比设置填充宽度
+  void SetPercent(uint8_t percent) { SetFill((percent * w_) / 100); }
+
+  void Draw(UiDisplay &display) override {
+    if (fill_ > 0)
+      display.FillRect(x_, y_, fill_, h_, 1);
+  }
+};
+
+/// @brief 图标/动画控件, 状态值变化时调用绘制函数
+class IconWidget : public UiWidget {
+public:
+  using DrawFunc = std::function<void(UiDisplay &, int)>;
+
+private:
+  DrawFunc draw_;
+  int state_ = 0;
+
+public:
+  IconWidget(int16_t x, int16_t y, int16_t w, int16_t h, DrawFunc draw)
+      : UiWidget(x, y, w, h), draw_(std::move(draw)) {}
+
+  void SetState(int state) {
+    if (state == state_)
+      return;
+    state_ = state;
+    dirty_ = true;
+  }
+
+  void Draw(UiDisplay &display) override { draw_(display, state_); }
+};
+
+/// @brief 趋势图样式
+enum class SparklineStyle : uint8_t {
+  BAR,  // 柱状图, 每列从底部填充
+  LINE, // 折线图, 每列与前一列的点相连
+};
+
+/// @brief 迷你趋势图控件, 每列对应一个采样, 最新样本位于最右列
+/// @note 新样本到来时整个区域左移(每页一次memmove), 只绘制新增的列;
+///       纵轴范围变化或新增列数超过宽度时才整体重绘。
+///       控件区域内的背景须为空白, 滚动空出的列直接清零
+class SparklineWidget : public UiWidget {
+private:
+  std::vector<double> samples_; // 环形缓冲区, 长度等于控件宽度
+  size_t head_ = 0;             // 最旧样本位置
+  size_t count_ = 0;
+  size_t pending_ = 0;          // 上次绘制后新增的样本数
+  double min_, max_;            // 纵轴范围
+  double base_max_;             // 自动缩放时纵轴上限的下限
+  SparklineStyle style_;
+  bool auto_scale_ = false;
+
+  /// @brief 第i个样本(0为最旧)
+  double At(size_t i) const { return samples_[(head_ + i) % samples_.size()]; }
+
+  /// @brief 不小于value的1/2/5系列整数值
+  static double NiceCeil(double value) {
+    if (value <= 0)
+      return 0;
+    double step = std::pow(10.0, std::floor(std::log10(value)));
+    for (double factor : {1.0, 2.0, 5.0, 10.0}) {
+      if (factor * step >= value)
+        return factor * step;
+    }
+    return 10.0 * step;
+  }
+
+  /// @brief 按窗口内的最大值调整纵轴上限
+  /// @return 上限变化时返回true(需要整体重绘)
+  bool Rescale() {
+    double peak = 0;
+    for (size_t i = 0; i < count_; i++)
+      peak = std::max(peak, At(i));
+    // 超出时扩大, 降到四分之一以下时缩小, 避免频繁重绘
+    if (peak <= max_ && (peak * 4 >= max_ || max_ <= base_max_))
+      return false;
+    const double max = std::max(base_max_, NiceCeil(peak - min_) + min_);
+    if (max == max_)
+      return false;
+    max_ = max;
+    return true;
+  }
+
+  /// @brief 采样值在纵轴上的比例
+  double Ratio(double value) const {
+    double ratio = (value - min_) / (max_ - min_ + 1e-9);
+    return std::max(0.0, std::min(ratio, 1.0));
+  }
+
+  /// @brief 绘制第i个样本对应的列
+  void DrawColumn(UiDisplay &display, size_t i) const {
+    const int16_t x = x_ + w_ - static_cast<int16_t>(count_) +
+                      static_cast<int16_t>(i);
+    if (style_ == SparklineStyle::BAR) {
+      int16_t bar = BarHeight(At(i));
+      if (bar > 0)
+        display.DrawFastVLine(x, y_ + h_ - bar, bar, 1);
+      return;
+    }
+    const int16_t y = PointY(At(i));
+    const int16_t prev = i > 0 ? PointY(At(i - 1)) : y;
+    display.DrawFastVLine(x, std::min(y, prev), std::abs(y - prev) + 1, 1);
+  }
+
+public:
+  SparklineWidget(int16_t x, int16_t y, int16_t w, int16_t h, double min,
+                  double max, SparklineStyle style = SparklineStyle::BAR)
+      : UiWidget(x, y, w, h), samples_(w, 0.0), min_(min), max_(max),
+        base_max_(max), style_(style) {}
+
+  /// @brief 纵轴上限随窗口内最大值自动调整(不低于构造时的上限)
+  void SetAutoScale(bool enable) { auto_scale_ = enable; }
+
+  /// @brief 追加一个采样值
+  void Push(double value) {
+    if (count_ < samples_.size()) {
+      samples_[(head_ + count_++) % samples_.size()] = value;
+    } else {
+      samples_[head_] = value;
+      head_ = (head_ + 1) % samples_.size();
+    }
+    if (auto_scale_ && Rescale())
+      dirty_ = true;
+    if (!dirty_ && ++pending_ >= samples_.size())
+      dirty_ = true;
+  }
+
+  /// @brief 采样值对应的柱高(像素)
+  int16_t BarHeight(double value) const {
+    return static_cast<int16_t>(Ratio(value) * h_ + 0.5);
+  }
+
+  /// @brief 采样值对应的折线点Y坐标
+  int16_t PointY(double value) const {
+    return y_ + h_ - 1 - static_cast<int16_t>(Ratio(value) * (h_ - 1) + 0.5);
+  }
+
+  /// @brief 当前纵轴上限
+  double Max() const { return max_; }
+
+  void Draw(UiDisplay &display) override {
+    for (size_t i = 0; i < count_; i++)
+      DrawColumn(display, i);
+    pending_ = 0;
+  }
+
+  bool DrawIncremental(UiDisplay &display) override {
+    if (pending_ == 0)
+      return false;
+    display.ScrollRectLeft(x_, y_, w_, h_, static_cast<int16_t>(pending_));
+    // 折线图最左列原本连向已移出窗口的样本, 需与整体重绘保持一致
+    if (style_ == SparklineStyle::LINE && count_ == samples_.size()) {
+      display.FillRect(x_, y_, 1, h_, 0);
+      DrawColumn(display, 0);
+    }
+    for (size_t i = count_ - pending_; i < count_; i++)
+      DrawColumn(display, i);
+    pending_ = 0;
+    return true;
+  }
+};
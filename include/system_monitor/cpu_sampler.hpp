@@ -0,0 +1,196 @@
+#pragma once
+#include "proc_reader.hpp"
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+/// @brief cpu信息(/proc/stat中一行的累计节拍)
+struct CpuTimeStamp {
+  uint64_t idle{0};    // idle + iowait
+  uint64_t total{0};   // 所有状态的总和
+  uint64_t user{0};    // user + nice
+  uint64_t system{0};  // system
+  uint64_t iowait{0};  // iowait
+  uint64_t irq{0};     // irq + softirq
+  uint64_t steal{0};   // steal
+  std::chrono::steady_clock::time_point time;
+};
+
+/// @brief CPU利用率(百分比, 0-100)
+struct CpuUtilization {
+  double total{0};  // 总使用率
+  double user{0};   // 用户态(含nice)
+  double system{0}; // 内核态
+  double iowait{0}; // IO等待
+  double irq{0};    // 硬中断 + 软中断
+  double steal{0};  // 被虚拟化宿主占用
+};
+
+/// @brief 一次采样得到的CPU使用情况
+struct CpuUsage {
+  CpuUtilization aggregate;         // 汇总("cpu"行)
+  std::vector<CpuUtilization> cores; // 各核心("cpuN"行)
+  double interval_sec{0};           // 与上次采样的时间间隔
+  std::chrono::steady_clock::time_point time;
+};
+
+/// @brief 非阻塞CPU使用率采样器
+/// @note 保存上次采样的节拍, 与本次调用求差, 不在调用方线程中休眠
+class CpuSampler {
+private:
+  ProcFile stat_file_{"/proc/stat", 16384};
+  std::vector<CpuTimeStamp> prev_stamps_; // [0]为汇总行, 其后为各核心
+  std::vector<CpuTimeStamp> curr_stamps_;
+  CpuUsage latest_;
+  mutable std::mutex mutex_;
+
+  // 后台定时采样
+  std::thread worker_;
+  std::condition_variable wakeup_;
+  bool running_ = false;
+
+  /// @brief 读取/proc/stat中所有cpu行
+  void ReadCpuStats(std::vector<CpuTimeStamp> &stamps) {
+    ProcScanner scanner(stat_file_.Read());
+    std::string_view line;
+    stamps.clear();
+    const auto now = std::chrono::steady_clock::now();
+
+    while (scanner.NextLine(line) && line.compare(0, 3, "cpu") == 0) {
+      ProcScanner::NextField(line); // 标签
+      uint64_t fields[8] = {}; // user nice system idle iowait irq softirq steal
+      for (uint64_t &field : fields) {
+        if (!ProcScanner::NextU64(line, field))
+          break;
+      }
+      const uint64_t user = fields[0], nice = fields[1], system = fields[2],
+                     idle = fields[3], iowait = fields[4], irq = fields[5],
+                     softirq = fields[6], steal = fields[7];
+
+      CpuTimeStamp stamp;
+      stamp.idle = idle + iowait;
+      stamp.total =
+          user + nice + system + idle + iowait + irq + softirq + steal;
+      stamp.user = user + nice;
+      stamp.system = system;
+      stamp.iowait = iowait;
+      stamp.irq = irq + softirq;
+      stamp.steal = steal;
+      stamp.time = now;
+      stamps.push_back(stamp);
+    }
+  }
+
+  /// @brief 由两次节拍计算利用率
+  static CpuUtilization Utilization(const CpuTimeStamp &prev,
+                                    const CpuTimeStamp &curr) {
+    CpuUtilization util;
+    if (curr.total <= prev.total)
+      return util;
+    const double total = static_cast<double>(curr.total - prev.total);
+    auto percent = [total](uint64_t now, uint64_t before) {
+      return now > before ? (now - before) * 100.0 / total : 0.0;
+    };
+    util.total = 100.0 - percent(curr.idle, prev.idle);
+    util.user = percent(curr.user, prev.user);
+    util.system = percent(curr.system, prev.system);
+    util.iowait = percent(curr.iowait, prev.iowait);
+    util.irq = percent(curr.irq, prev.irq);
+    util.steal = percent(curr.steal, prev.steal);
+    return util;
+  }
+
+  /// @brief 采样并更新latest_, 调用方需持有mutex_
+  void SampleLocked() {
+    ReadCpuStats(curr_stamps_);
+    if (curr_stamps_.empty())
+      return;
+
+    // 核心数变化(热插拔)时重新建立基准
+    if (prev_stamps_.size() != curr_stamps_.size()) {
+      prev_stamps_.swap(curr_stamps_);
+      return;
+    }
+    // 间隔内节拍未增长时保留上次结果, 不推进基准
+    if (curr_stamps_[0].total <= prev_stamps_[0].total)
+      return;
+
+    latest_.aggregate = Utilization(prev_stamps_[0], curr_stamps_[0]);
+    latest_.cores.resize(curr_stamps_.size() - 1);
+    for (size_t i = 1; i < curr_stamps_.size(); ++i)
+      latest_.cores[i - 1] = Utilization(prev_stamps_[i], curr_stamps_[i]);
+    latest_.interval_sec = std::chrono::duration<double>(
+                               curr_stamps_[0].time - prev_stamps_[0].time)
+                               .count();
+    latest_.time = curr_stamps_[0].time;
+    prev_stamps_.swap(curr_stamps_);
+  }
+
+public:
+  CpuSampler() { ReadCpuStats(prev_stamps_); }
+
+  CpuSampler(const CpuSampler &) = delete;
+  CpuSampler &operator=(const CpuSampler &) = delete;
+
+  /// @brief 立即采样一次, 返回与上次采样之间的平均利用率
+  /// @note 后台采样运行时不推进基准, 直接返回最近结果
+  CpuUsage Sample() {
+    CpuUsage usage;
+    Sample(usage);
+    return usage;
+  }
+
+  /// @brief 同Sample(), 结果写入调用方复用的对象, 稳态下不分配内存
+  void Sample(CpuUsage &usage) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (!running_)
+      SampleLocked();
+    usage = latest_;
+  }
+
+  /// @brief 最近一次采样结果
+  CpuUsage Latest() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return latest_;
+  }
+
+  /// @brief 启动后台定时采样
+  /// @param period 采样周期
+  void Start(std::chrono::milliseconds period) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (running_)
+      return;
+    running_ = true;
+    worker_ = std::thread([this, period] {
+      std::unique_lock<std::mutex> lock(mutex_);
+      while (running_) {
+        if (wakeup_.wait_for(lock, period, [this] { return !running_; }))
+          break;
+        SampleLocked();
+      }
+    });
+  }
+
+  /// @brief 停止后台采样
+  void Stop() {
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      if (!running_)
+        return;
+      running_ = false;
+    }
+    wakeup_.notify_all();
+    if (worker_.joinable())
+      worker_.join();
+  }
+
+  bool IsRunning() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return running_;
+  }
+
+  ~CpuSampler() { Stop(); }
+};
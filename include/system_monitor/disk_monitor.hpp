@@ -0,0 +1,386 @@
+#pragma once
+#include "proc_reader.hpp"
+#include <algorithm>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <fnmatch.h>
+#include <memory>
+#include <mutex>
+#include <poll.h>
+#include <string>
+#include <string_view>
+#include <sys/statvfs.h>
+#include <thread>
+#include <vector>
+
+/// @brief 磁盘信息
+struct DiskInfo {
+  std::string mount_point;      // 挂载点路径
+  std::string device;           // 块设备(如/dev/mmcblk0p2)
+  std::string fs_type;          // 文件系统类型
+  uint64_t block_size{0};       // 文件系统块大小(字节)
+  uint64_t total_blocks{0};     // 总块数
+  uint64_t free_blocks{0};      // 空闲块数
+  uint64_t available_blocks{0}; // 可用块数(考虑保留空间)
+  uint64_t total_bytes{0};      // 总空间(字节)
+  uint64_t free_bytes{0};       // 空闲空间(字节)
+  uint64_t available_bytes{0};  // 可用空间(字节)
+  double usage_percent{0};      // 使用率百分比(0-100)
+  bool valid{false};            // 是否已成功统计(超时或失败时为false)
+};
+
+/// @brief 由statvfs结果填充磁盘用量
+inline void FillDiskInfo(const struct statvfs &vfs, DiskInfo &info) {
+  info.block_size = vfs.f_frsize;       // 文件系统块大小
+  info.total_blocks = vfs.f_blocks;     // 总块数
+  info.free_blocks = vfs.f_bfree;       // 空闲块数
+  info.available_blocks = vfs.f_bavail; // 可用块数
+
+  // 计算字节大小
+  info.total_bytes = info.total_blocks * info.block_size;
+  info.free_bytes = info.free_blocks * info.block_size;
+  info.available_bytes = info.available_blocks * info.block_size;
+
+  // 计算使用率百分比
+  if (info.total_bytes > 0) {
+    info.usage_percent =
+        100.0 *
+        (1.0 - static_cast<double>(info.available_bytes) / info.total_bytes);
+  } else {
+    info.usage_percent = 0.0;
+  }
+  info.valid = true;
+}
+
+/// @brief 磁盘监控配置
+struct DiskMonitorConfig {
+  uint32_t stat_period_ms = 30000;  // statvfs刷新周期
+  uint32_t stat_timeout_ms = 2000;  // 单次statvfs超时, 超时的挂载点暂停统计
+  bool include_loop = false;        // 是否包含loop设备(如squashfs镜像)
+  std::vector<std::string> exclude; // 排除的挂载点通配(fnmatch)
+  // 不限块设备也统计的挂载点(如overlay根文件系统或网络挂载)
+  std::vector<std::string> extra = {"/"};
+};
+
+/// @brief 多挂载点磁盘监控
+/// @note 启动时解析/proc/self/mountinfo, 之后仅在poll()报告挂载表变化时重新解析;
+///       只保留块设备挂载(同一设备的多次挂载只取第一个)。
+///       statvfs在后台线程按周期执行, 调用方只读取缓存。挂起的挂载点
+///       (如掉线的USB设备)超时后标记为无效, 卡住的线程被分离并由新线程
+///       继续统计其余挂载点, 不会阻塞采样线程
+class DiskMonitor {
+private:
+  /// @brief 与后台线程共享的状态, 线程挂起无法回收时由其单独持有
+  struct Shared {
+    std::mutex mutex;
+    std::condition_variable wake_cv;  // 唤醒后台线程
+    std::condition_variable idle_cv;  // 后台线程完成一次statvfs
+    DiskMonitorConfig config;
+    std::vector<DiskInfo> disks;      // 挂载点及其缓存的统计结果
+    std::vector<std::string> hung;    // 超时的挂载点, 卸载或恢复响应前不再统计
+    uint64_t generation = 0;          // 挂载表版本, 变化后丢弃旧结果
+    bool stop = false;
+    bool wake = false;
+    uint64_t worker_id = 0;           // 当前后台线程编号, 超时后更换
+    bool busy = false;                // 当前后台线程正在执行statvfs
+    std::string busy_path;            // 正在统计的挂载点
+    std::chrono::steady_clock::time_point busy_since;
+    uint64_t rounds = 0;              // 完成的统计轮数
+    uint64_t timeouts = 0;            // 超时次数
+  };
+
+  std::shared_ptr<Shared> shared_ = std::make_shared<Shared>();
+  std::thread worker_;
+  ProcFile mountinfo_file_{"/proc/self/mountinfo", 16384};
+  uint64_t mount_table_changes_ = 0;
+
+  /// @brief 还原mountinfo中的八进制转义(如空格为\040)
+  static std::string Unescape(std::string_view text) {
+    std::string result;
+    result.reserve(text.size());
+    for (size_t i = 0; i < text.size(); i++) {
+      if (text[i] == '\\' && i + 3 < text.size() && text[i + 1] >= '0' &&
+          text[i + 1] <= '3') {
+        result.push_back(static_cast<char>((text[i + 1] - '0') * 64 +
+                                           (text[i + 2] - '0') * 8 +
+                                           (text[i + 3] - '0')));
+        i += 3;
+      } else {
+        result.push_back(text[i]);
+      }
+    }
+    return result;
+  }
+
+  bool Excluded(const std::string &mount_point) const {
+    for (const std::string &pattern : shared_->config.exclude) {
+      if (fnmatch(pattern.c_str(), mount_point.c_str(), 0) == 0)
+        return true;
+    }
+    return false;
+  }
+
+  bool Extra(const std::string &mount_point) const {
+    const std::vector<std::string> &extra = shared_->config.extra;
+    return std::find(extra.begin(), extra.end(), mount_point) != extra.end();
+  }
+
+  /// @brief 解析挂载表, 保留块设备挂载
+  std::vector<DiskInfo> ParseMountInfo() {
+    std::vector<DiskInfo> disks;
+    std::vector<std::string_view> devices; // 已收录的major:minor
+    ProcScanner scanner(mountinfo_file_.Read());
+    std::string_view line;
+    while (scanner.NextLine(line)) {
+      // 格式: ID 父ID major:minor 根 挂载点 选项 [可选字段...] - 类型 来源 超级块选项
+      ProcScanner::NextField(line);
+      ProcScanner::NextField(line);
+      const std::string_view device_id = ProcScanner::NextField(line);
+      const std::string_view root = ProcScanner::NextField(line);
+      const std::string_view mount_point = ProcScanner::NextField(line);
+      std::string_view field;
+      do {
+        field = ProcScanner::NextField(line);
+      } while (!field.empty() && field != "-");
+      const std::string_view fs_type = ProcScanner::NextField(line);
+      const std::string_view source = ProcScanner::NextField(line);
+
+      DiskInfo info;
+      info.mount_point = Unescape(mount_point);
+      // 块设备: 来源为/dev/下的设备且主设备号非0; 跳过绑定挂载的子目录
+      const bool block = source.substr(0, 5) == "/dev/" &&
+                         device_id.substr(0, 2) != "0:" && root == "/" &&
+                         (shared_->config.include_loop ||
+                          source.substr(0, 9) != "/dev/loop");
+      if (!block && !Extra(info.mount_point))
+        continue;
+      if (Excluded(info.mount_point) ||
+          std::find(devices.begin(), devices.end(), device_id) != devices.end())
+        continue;
+      info.device = Unescape(source);
+      info.fs_type = std::string(fs_type);
+      devices.push_back(device_id);
+      disks.push_back(std::move(info));
+    }
+    return disks;
+  }
+
+  /// @brief 重新解析挂载表, 挂载点不变时保留缓存的统计结果
+  void ReloadMounts() {
+    std::vector<DiskInfo> disks = ParseMountInfo();
+    std::lock_guard<std::mutex> lock(shared_->mutex);
+    for (DiskInfo &disk : disks) {
+      for (const DiskInfo &old : shared_->disks) {
+        if (old.mount_point == disk.mount_point && old.device == disk.device) {
+          disk = old;
+          break;
+        }
+      }
+    }
+    // 仍在挂载表中的超时挂载点继续跳过, 避免每次挂载表变化都再卡住一个线程
+    std::vector<std::string> &hung = shared_->hung;
+    hung.erase(std::remove_if(hung.begin(), hung.end(),
+                              [&](const std::string &path) {
+                                return std::none_of(
+                                    disks.begin(), disks.end(),
+                                    [&](const DiskInfo &disk) {
+                                      return disk.mount_point == path;
+                                    });
+                              }),
+               hung.end());
+    for (DiskInfo &disk : disks) {
+      if (std::find(hung.begin(), hung.end(), disk.mount_point) != hung.end())
+        disk.valid = false;
+    }
+    shared_->disks = std::move(disks);
+    shared_->generation++;
+    shared_->wake = true;
+    shared_->wake_cv.notify_one();
+  }
+
+  /// @brief 后台线程: 逐个挂载点执行statvfs, 结果写回缓存
+  /// @param id 线程编号, 与shared->worker_id不同时说明已因超时被替换, 立即退出
+  static void WorkerLoop(std::shared_ptr<Shared> shared, uint64_t id) {
+    std::unique_lock<std::mutex> lock(shared->mutex);
+    std::vector<std::string> paths;
+    while (!shared->stop && shared->worker_id == id) {
+      const uint64_t generation = shared->generation;
+      paths.clear();
+      for (const DiskInfo &disk : shared->disks) {
+        if (std::find(shared->hung.begin(), shared->hung.end(),
+                      disk.mount_point) == shared->hung.end())
+          paths.push_back(disk.mount_point);
+      }
+
+      for (const std::string &path : paths) {
+        if (shared->stop || shared->generation != generation)
+          break;
+        shared->busy = true;
+        shared->busy_path = path;
+        shared->busy_since = std::chrono::steady_clock::now();
+        lock.unlock();
+
+        struct statvfs vfs;
+        const bool ok = statvfs(path.c_str(), &vfs) == 0;
+
+        lock.lock();
+        if (shared->worker_id != id) {
+          // 已被替换: 结果可能过时, 丢弃; 挂载点恢复了响应, 由当前线程重新统计
+          auto &hung = shared->hung;
+          hung.erase(std::remove(hung.begin(), hung.end(), path), hung.end());
+          shared->wake = true;
+          shared->wake_cv.notify_all();
+          return;
+        }
+        shared->busy = false;
+        shared->idle_cv.notify_all();
+        if (shared->generation != generation)
+          break;
+        for (DiskInfo &disk : shared->disks) {
+          if (disk.mount_point != path)
+            continue;
+          if (ok)
+            FillDiskInfo(vfs, disk);
+          else
+            disk.valid = false;
+        }
+      }
+
+      shared->rounds++;
+      shared->wake_cv.wait_for(
+          lock, std::chrono::milliseconds(shared->config.stat_period_ms),
+          [&] { return shared->stop || shared->wake; });
+      shared->wake = false;
+    }
+  }
+
+  /// @brief 检查后台线程是否卡在某个挂载点上
+  /// @note 超时后标记该挂载点, 分离卡住的线程(其持有shared_的引用)并启动
+  ///       新线程统计其余挂载点; 旧线程返回后发现编号已变化即退出
+  void CheckTimeout() {
+    uint64_t id;
+    {
+      std::lock_guard<std::mutex> lock(shared_->mutex);
+      if (!shared_->busy ||
+          std::chrono::steady_clock::now() - shared_->busy_since <
+              std::chrono::milliseconds(shared_->config.stat_timeout_ms))
+        return;
+      if (std::find(shared_->hung.begin(), shared_->hung.end(),
+                    shared_->busy_path) == shared_->hung.end())
+        shared_->hung.push_back(shared_->busy_path);
+      shared_->timeouts++;
+      for (DiskInfo &disk : shared_->disks) {
+        if (disk.mount_point == shared_->busy_path)
+          disk.valid = false;
+      }
+      shared_->busy = false;
+      id = ++shared_->worker_id;
+    }
+    worker_.detach();
+    worker_ = std::thread(WorkerLoop, shared_, id);
+  }
+
+public:
+  explicit DiskMonitor(const DiskMonitorConfig &config = {}) {
+    shared_->config = config;
+    if (mountinfo_file_.IsOpen())
+      shared_->disks = ParseMountInfo();
+  }
+
+  DiskMonitor(const DiskMonitor &) = delete;
+  DiskMonitor &operator=(const DiskMonitor &) = delete;
+
+  ~DiskMonitor() { Stop(); }
+
+  /// @brief 更新配置并重新解析挂载表
+  void Configure(const DiskMonitorConfig &config) {
+    {
+      std::lock_guard<std::mutex> lock(shared_->mutex);
+      shared_->config = config;
+    }
+    if (mountinfo_file_.IsOpen())
+      ReloadMounts();
+  }
+
+  /// @brief 检查挂载表变化与statvfs超时, 首次调用时启动后台线程
+  /// @note 不执行任何可能阻塞的系统调用, 可在采样线程中频繁调用
+  void Refresh() {
+    if (!worker_.joinable()) {
+      std::lock_guard<std::mutex> lock(shared_->mutex);
+      worker_ = std::thread(WorkerLoop, shared_, shared_->worker_id);
+    }
+
+    // 挂载表变化时mountinfo报告POLLPRI/POLLERR, poll本身会清除该事件
+    struct pollfd pfd = {mountinfo_file_.Fd(), POLLPRI, 0};
+    if (pfd.fd >= 0 && poll(&pfd, 1, 0) > 0 &&
+        (pfd.revents & (POLLPRI | POLLERR))) {
+      mount_table_changes_++;
+      ReloadMounts();
+    }
+    CheckTimeout();
+  }
+
+  /// @brief 立即重新统计所有挂载点(不等待结果)
+  void Wake() {
+    std::lock_guard<std::mutex> lock(shared_->mutex);
+    shared_->wake = true;
+    shared_->wake_cv.notify_one();
+  }
+
+  /// @brief 停止后台线程; 线程卡在statvfs中超时仍未返回时将其分离
+  void Stop() {
+    if (!worker_.joinable())
+      return;
+    std::unique_lock<std::mutex> lock(shared_->mutex);
+    shared_->stop = true;
+    shared_->wake_cv.notify_one();
+    const bool idle = shared_->idle_cv.wait_for(
+        lock, std::chrono::milliseconds(shared_->config.stat_timeout_ms),
+        [&] { return !shared_->busy; });
+    lock.unlock();
+    if (idle)
+      worker_.join();
+    else
+      worker_.detach();
+  }
+
+  /// @brief 获取所有挂载点的缓存统计结果
+  void GetDisks(std::vector<DiskInfo> &disks) const {
+    std::lock_guard<std::mutex> lock(shared_->mutex);
+    disks = shared_->disks;
+  }
+
+  /// @brief 按挂载点查找缓存的统计结果
+  bool Find(const std::string &mount_point, DiskInfo &info) const {
+    std::lock_guard<std::mutex> lock(shared_->mutex);
+    for (const DiskInfo &disk : shared_->disks) {
+      if (disk.mount_point == mount_point) {
+        info = disk;
+        return true;
+      }
+    }
+    return false;
+  }
+
+  /// @brief 监控的挂载点数量
+  size_t Count() const {
+    std::lock_guard<std::mutex> lock(shared_->mutex);
+    return shared_->disks.size();
+  }
+
+  /// @brief 后台线程完成的统计轮数
+  uint64_t Rounds() const {
+    std::lock_guard<std::mutex> lock(shared_->mutex);
+    return shared_->rounds;
+  }
+
+  /// @brief statvfs超时次数
+  uint64_t Timeouts() const {
+    std::lock_guard<std::mutex> lock(shared_->mutex);
+    return shared_->timeouts;
+  }
+
+  /// @brief 检测到的挂载表变化次数
+  uint64_t MountTableChanges() const { return mount_table_changes_; }
+};
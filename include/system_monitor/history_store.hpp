@@ -0,0 +1,680 @@
+#pragma once
+#include "metric_history.hpp"
+#include <algorithm>
+#include <cerrno>
+#include <cstdint>
+#include <cstring>
+#include <fcntl.h>
+#include <iostream>
+#include <string>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include <vector>
+
+// 历史文件格式(小端, 仅追加):
+//   文件头 HistoryFileHeader
+//   数据块 HistoryBlockHeader + 位流负载, 重复
+// 每个数据块独立压缩: 时间戳用二阶差分(delta-of-delta), 各浮点通道与前值
+// 异或后只保存有效位(Gorilla编码)。索引文件(<path>.idx)为HistoryIndexEntry
+// 数组, 缺失或不完整时读取方扫描块头重建。
+
+constexpr uint64_t HISTORY_FILE_MAGIC = 0x5453494844454C4FULL; // "OLEDHIST"
+constexpr uint32_t HISTORY_BLOCK_MAGIC = 0x4B4C4248;            // "HBLK"
+constexpr uint32_t HISTORY_FORMAT_VERSION = 1;
+constexpr size_t HISTORY_CHANNELS = 8; // MetricSample中的浮点通道数
+
+static_assert(sizeof(MetricSample) ==
+                  sizeof(int64_t) + HISTORY_CHANNELS * sizeof(float),
+              "MetricSample布局与历史文件格式不一致");
+
+/// @brief 文件头
+struct HistoryFileHeader {
+  uint64_t magic;
+  uint32_t version;
+  uint32_t channels;
+  uint64_t reserved[2];
+};
+
+/// @brief 数据块头
+/// @note 负载按字节紧接, 块头可能位于任意偏移, 因此按1字节对齐以便直接读取
+struct __attribute__((packed)) HistoryBlockHeader {
+  uint32_t magic;
+  uint32_t count;         // 样本数
+  int64_t first_time;     // 第一个样本时间(毫秒)
+  int64_t last_time;      // 最后一个样本时间(毫秒)
+  uint32_t payload_bytes; // 位流长度
+  uint32_t checksum;      // 位流的FNV-1a校验, 用于发现写入中断的尾块
+};
+static_assert(sizeof(HistoryBlockHeader) == 32, "块头布局与文件格式不一致");
+
+/// @brief 块索引项
+struct HistoryIndexEntry {
+  int64_t first_time;
+  int64_t last_time;
+  uint64_t offset; // 块头在数据文件中的偏移
+};
+
+/// @brief FNV-1a 32位校验
+inline uint32_t HistoryChecksum(const uint8_t *data, size_t size) {
+  uint32_t hash = 2166136261u;
+  for (size_t i = 0; i < size; i++) {
+    hash ^= data[i];
+    hash *= 16777619u;
+  }
+  return hash;
+}
+
+/// @brief 扫描数据块, 校验失败的块(写入中断或介质损坏)向后查找下一个块头跳过
+/// @param index 输出有效块的索引
+/// @return 最后一个有效块的结束偏移(没有有效块时为文件头大小)
+inline uint64_t ScanHistoryBlocks(const uint8_t *data, size_t size,
+                                  std::vector<HistoryIndexEntry> &index) {
+  index.clear();
+  uint64_t offset = sizeof(HistoryFileHeader);
+  uint64_t valid_end = offset;
+  while (offset + sizeof(HistoryBlockHeader) <= size) {
+    HistoryBlockHeader header;
+    std::memcpy(&header, data + offset, sizeof(header));
+    const uint64_t end = offset + sizeof(header) + header.payload_bytes;
+    if (header.magic == HISTORY_BLOCK_MAGIC && end <= size &&
+        HistoryChecksum(data + offset + sizeof(header), header.payload_bytes) ==
+            header.checksum) {
+      index.push_back({header.first_time, header.last_time, offset});
+      offset = valid_end = end;
+      continue;
+    }
+    // 逐字节查找下一个块魔数, 误命中由校验和排除
+    offset++;
+    while (offset + sizeof(HISTORY_BLOCK_MAGIC) <= size &&
+           std::memcmp(data + offset, &HISTORY_BLOCK_MAGIC,
+                       sizeof(HISTORY_BLOCK_MAGIC)) != 0)
+      offset++;
+  }
+  return valid_end;
+}
+
+/// @brief 位流写入
+class HistoryBitWriter {
+private:
+  std::vector<uint8_t> &bytes_;
+  uint8_t used_ = 8; // 最后一个字节已使用的位数
+
+public:
+  explicit HistoryBitWriter(std::vector<uint8_t> &bytes) : bytes_(bytes) {
+    Reset();
+  }
+
+  void Reset() {
+    bytes_.clear();
+    used_ = 8;
+  }
+
+  /// @brief 写入value的低bits位(高位在前)
+  void Write(uint64_t value, uint8_t bits) {
+    while (bits > 0) {
+      if (used_ == 8) {
+        bytes_.push_back(0);
+        used_ = 0;
+      }
+      const uint8_t take = std::min<uint8_t>(bits, 8 - used_);
+      const uint8_t chunk =
+          static_cast<uint8_t>((value >> (bits - take)) & ((1u << take) - 1));
+      bytes_.back() |= static_cast<uint8_t>(chunk << (8 - used_ - take));
+      used_ += take;
+      bits -= take;
+    }
+  }
+};
+
+/// @brief 位流读取
+class HistoryBitReader {
+private:
+  const uint8_t *data_;
+  size_t size_bits_;
+  size_t pos_ = 0;
+
+public:
+  HistoryBitReader(const uint8_t *data, size_t size)
+      : data_(data), size_bits_(size * 8) {}
+
+  /// @brief 读取bits位, 越界时返回false
+  bool Read(uint8_t bits, uint64_t &value) {
+    if (pos_ + bits > size_bits_)
+      return false;
+    value = 0;
+    while (bits > 0) {
+      const uint8_t offset = pos_ % 8;
+      const uint8_t take = std::min<uint8_t>(bits, 8 - offset);
+      const uint8_t byte = data_[pos_ / 8];
+      value = (value << take) |
+              ((byte >> (8 - offset - take)) & ((1u << take) - 1));
+      pos_ += take;
+      bits -= take;
+    }
+    return true;
+  }
+};
+
+/// @brief 单个数据块的编码状态
+class HistoryBlockEncoder {
+private:
+  std::vector<uint8_t> payload_;
+  HistoryBitWriter writer_{payload_};
+  uint32_t count_ = 0;
+  int64_t first_time_ = 0;
+  int64_t prev_time_ = 0;
+  int64_t prev_delta_ = 0;
+  uint32_t prev_values_[HISTORY_CHANNELS] = {};
+  uint8_t prev_leading_[HISTORY_CHANNELS] = {};
+  uint8_t prev_trailing_[HISTORY_CHANNELS] = {};
+
+  static void Split(const MetricSample &sample, uint32_t *values) {
+    std::memcpy(values, reinterpret_cast<const uint8_t *>(&sample) +
+                            sizeof(int64_t),
+                HISTORY_CHANNELS * sizeof(uint32_t));
+  }
+
+  void WriteTimestamp(int64_t time) {
+    const int64_t delta = time - prev_time_;
+    const int64_t dod = delta - prev_delta_;
+    if (dod == 0) {
+      writer_.Write(0b0, 1);
+    } else if (dod >= -63 && dod <= 64) {
+      writer_.Write(0b10, 2);
+      writer_.Write(static_cast<uint64_t>(dod + 63), 7);
+    } else if (dod >= -255 && dod <= 256) {
+      writer_.Write(0b110, 3);
+      writer_.Write(static_cast<uint64_t>(dod + 255), 9);
+    } else if (dod >= -2047 && dod <= 2048) {
+      writer_.Write(0b1110, 4);
+      writer_.Write(static_cast<uint64_t>(dod + 2047), 12);
+    } else {
+      writer_.Write(0b1111, 4);
+      writer_.Write(static_cast<uint64_t>(dod), 64);
+    }
+    prev_delta_ = delta;
+    prev_time_ = time;
+  }
+
+  void WriteValue(size_t channel, uint32_t value) {
+    const uint32_t xored = value ^ prev_values_[channel];
+    prev_values_[channel] = value;
+    if (xored == 0) {
+      writer_.Write(0b0, 1);
+      return;
+    }
+
+    const uint8_t leading = std::min(__builtin_clz(xored), 31);
+    const uint8_t trailing = __builtin_ctz(xored);
+    // 有效位落在上一个窗口内时复用窗口, 省去窗口描述
+    const uint8_t prev_leading = prev_leading_[channel];
+    const uint8_t prev_trailing = prev_trailing_[channel];
+    if (count_ > 1 && leading >= prev_leading && trailing >= prev_trailing) {
+      writer_.Write(0b10, 2);
+      writer_.Write(xored >> prev_trailing, 32 - prev_leading - prev_trailing);
+      return;
+    }
+
+    const uint8_t bits = 32 - leading - trailing;
+    writer_.Write(0b11, 2);
+    writer_.Write(leading, 5);
+    writer_.Write(bits - 1, 5);
+    writer_.Write(xored >> trailing, bits);
+    prev_leading_[channel] = leading;
+    prev_trailing_[channel] = trailing;
+  }
+
+public:
+  void Append(const MetricSample &sample) {
+    uint32_t values[HISTORY_CHANNELS];
+    Split(sample, values);
+
+    if (count_ == 0) {
+      first_time_ = prev_time_ = sample.time_ms;
+      prev_delta_ = 0;
+      for (size_t i = 0; i < HISTORY_CHANNELS; i++) {
+        writer_.Write(values[i], 32);
+        prev_values_[i] = values[i];
+        prev_leading_[i] = prev_trailing_[i] = 0;
+      }
+    } else {
+      WriteTimestamp(sample.time_ms);
+      for (size_t i = 0; i < HISTORY_CHANNELS; i++)
+        WriteValue(i, values[i]);
+    }
+    count_++;
+  }
+
+  uint32_t Count() const { return count_; }
+  int64_t FirstTime() const { return first_time_; }
+  int64_t LastTime() const { return prev_time_; }
+  const std::vector<uint8_t> &Payload() const { return payload_; }
+
+  void Reset() {
+    writer_.Reset();
+    count_ = 0;
+  }
+};
+
+/// @brief 解码一个数据块
+/// @return 成功解码的样本数
+inline size_t DecodeHistoryBlock(const HistoryBlockHeader &header,
+                                 const uint8_t *payload,
+                                 std::vector<MetricSample> &out,
+                                 int64_t from_ms, int64_t to_ms) {
+  HistoryBitReader reader(payload, header.payload_bytes);
+  uint32_t values[HISTORY_CHANNELS];
+  uint8_t leading[HISTORY_CHANNELS] = {};
+  uint8_t trailing[HISTORY_CHANNELS] = {};
+  int64_t time = header.first_time;
+  int64_t delta = 0;
+  size_t decoded = 0;
+
+  for (uint32_t n = 0; n < header.count; n++) {
+    uint64_t bits = 0;
+    if (n == 0) {
+      for (uint32_t &value : values) {
+        if (!reader.Read(32, bits))
+          return decoded;
+        value = static_cast<uint32_t>(bits);
+      }
+    } else {
+      // 时间戳: 前缀0/10/110/1110/1111对应不同的二阶差分宽度
+      uint8_t prefix = 0;
+      while (prefix < 4) {
+        if (!reader.Read(1, bits))
+          return decoded;
+        if (bits == 0)
+          break;
+        prefix++;
+      }
+      static constexpr uint8_t DOD_BITS[] = {0, 7, 9, 12, 64};
+      static constexpr int64_t DOD_BIAS[] = {0, 63, 255, 2047, 0};
+      int64_t dod = 0;
+      if (prefix > 0) {
+        if (!reader.Read(DOD_BITS[prefix], bits))
+          return decoded;
+        dod = static_cast<int64_t>(bits) - DOD_BIAS[prefix];
+      }
+      delta += dod;
+      time += delta;
+
+      for (size_t i = 0; i < HISTORY_CHANNELS; i++) {
+        if (!reader.Read(1, bits))
+          return decoded;
+        if (bits == 0)
+          continue;
+        if (!reader.Read(1, bits))
+          return decoded;
+        if (bits == 1) {
+          uint64_t lead = 0, len = 0;
+          if (!reader.Read(5, lead) || !reader.Read(5, len))
+            return decoded;
+          leading[i] = static_cast<uint8_t>(lead);
+          trailing[i] = static_cast<uint8_t>(32 - lead - (len + 1));
+        }
+        const uint8_t width = 32 - leading[i] - trailing[i];
+        if (!reader.Read(width, bits))
+          return decoded;
+        values[i] ^= static_cast<uint32_t>(bits) << trailing[i];
+      }
+    }
+
+    if (time >= from_ms && time <= to_ms) {
+      MetricSample sample;
+      sample.time_ms = time;
+      std::memcpy(reinterpret_cast<uint8_t *>(&sample) + sizeof(int64_t),
+                  values, sizeof(values));
+      out.push_back(sample);
+    }
+    decoded++;
+  }
+  return decoded;
+}
+
+/// @brief 历史文件写入配置
+struct HistoryStoreConfig {
+  uint32_t block_samples = 256;        // 每块最多样本数
+  int64_t max_block_span_ms = 300000;  // 单块最长时间跨度, 到达后落盘
+};
+
+/// @brief 仅追加的历史文件写入器
+/// @note 样本先在内存中压缩, 整块一次write()写入, 减少SD卡写放大
+class HistoryStoreWriter {
+private:
+  HistoryStoreConfig config_;
+  std::string path_;
+  int fd_ = -1;
+  int index_fd_ = -1;
+  HistoryBlockEncoder encoder_;
+  std::vector<uint8_t> block_buffer_; // 块头 + 负载, 一次写入
+  uint64_t file_size_ = 0;
+  uint64_t blocks_written_ = 0;
+  uint64_t samples_written_ = 0;
+
+  static bool WriteAll(int fd, const void *data, size_t size) {
+    const uint8_t *ptr = static_cast<const uint8_t *>(data);
+    while (size > 0) {
+      ssize_t n = write(fd, ptr, size);
+      if (n < 0 && errno == EINTR)
+        continue;
+      if (n <= 0)
+        return false;
+      ptr += n;
+      size -= static_cast<size_t>(n);
+    }
+    return true;
+  }
+
+  /// @brief 检查已有文件, 截掉最后一个有效块之后的数据(崩溃时写了一半的块)
+  /// @note 否则新块追加在损坏的尾部之后, 旧版本读取方会在损坏处停止
+  bool Recover(std::vector<HistoryIndexEntry> &index) {
+    if (file_size_ < sizeof(HistoryFileHeader)) {
+      std::cerr << "历史文件格式错误: " << path_ << std::endl;
+      return false;
+    }
+    void *mapped = mmap(nullptr, file_size_, PROT_READ, MAP_SHARED, fd_, 0);
+    if (mapped == MAP_FAILED) {
+      std::cerr << "mmap失败: " << path_ << std::endl;
+      return false;
+    }
+    const auto *data = static_cast<const uint8_t *>(mapped);
+    const auto *header = reinterpret_cast<const HistoryFileHeader *>(data);
+    const bool valid_header = header->magic == HISTORY_FILE_MAGIC &&
+                              header->version == HISTORY_FORMAT_VERSION &&
+                              header->channels == HISTORY_CHANNELS;
+    const uint64_t valid_end =
+        valid_header ? ScanHistoryBlocks(data, file_size_, index) : 0;
+    munmap(mapped, file_size_);
+    if (!valid_header) {
+      std::cerr << "历史文件格式错误: " << path_ << std::endl;
+      return false;
+    }
+
+    if (valid_end < file_size_) {
+      std::cerr << "历史文件尾部不完整, 截断 " << file_size_ - valid_end
+                << " 字节: " << path_ << std::endl;
+      if (ftruncate(fd_, static_cast<off_t>(valid_end)) != 0) {
+        std::cerr << "截断历史文件失败: " << std::strerror(errno) << std::endl;
+        return false;
+      }
+      file_size_ = valid_end;
+    }
+    return true;
+  }
+
+public:
+  explicit HistoryStoreWriter(const HistoryStoreConfig &config = {})
+      : config_(config) {}
+
+  HistoryStoreWriter(const HistoryStoreWriter &) = delete;
+  HistoryStoreWriter &operator=(const HistoryStoreWriter &) = delete;
+
+  ~HistoryStoreWriter() { Close(); }
+
+  /// @brief 打开(或创建)历史文件并定位到末尾
+  bool Open(const std::string &path) {
+    Close();
+    path_ = path;
+    fd_ = open(path.c_str(), O_RDWR | O_CREAT | O_APPEND | O_CLOEXEC, 0644);
+    if (fd_ < 0) {
+      std::cerr << "无法打开历史文件: " << path << " (" << std::strerror(errno)
+                << ")" << std::endl;
+      return false;
+    }
+
+    struct stat st;
+    fstat(fd_, &st);
+    file_size_ = static_cast<uint64_t>(st.st_size);
+    const bool new_file = file_size_ == 0;
+    if (new_file) {
+      HistoryFileHeader header{};
+      header.magic = HISTORY_FILE_MAGIC;
+      header.version = HISTORY_FORMAT_VERSION;
+      header.channels = HISTORY_CHANNELS;
+      if (!WriteAll(fd_, &header, sizeof(header))) {
+        Close();
+        return false;
+      }
+      file_size_ = sizeof(header);
+    }
+    std::vector<HistoryIndexEntry> index;
+    if (!new_file && !Recover(index)) {
+      Close();
+      return false;
+    }
+    // 索引按恢复后的数据重写, 此后随数据块追加
+    index_fd_ = open((path + ".idx").c_str(),
+                     O_WRONLY | O_CREAT | O_APPEND | O_TRUNC | O_CLOEXEC, 0644);
+    if (index_fd_ >= 0 && !index.empty())
+      WriteAll(index_fd_, index.data(), index.size() * sizeof(index[0]));
+    return true;
+  }
+
+  bool IsOpen() const { return fd_ >= 0; }
+
+  /// @brief 追加一个样本, 块满或跨度超限时写入文件
+  bool Append(const MetricSample &sample) {
+    if (fd_ < 0)
+      return false;
+    if (encoder_.Count() > 0 &&
+        (sample.time_ms < encoder_.LastTime() ||
+         sample.time_ms - encoder_.FirstTime() > config_.max_block_span_ms)) {
+      if (!Flush())
+        return false;
+    }
+    encoder_.Append(sample);
+    samples_written_++;
+    if (encoder_.Count() >= config_.block_samples)
+      return Flush();
+    return true;
+  }
+
+  /// @brief 将当前未满的块写入文件
+  bool Flush() {
+    if (fd_ < 0 || encoder_.Count() == 0)
+      return true;
+
+    const std::vector<uint8_t> &payload = encoder_.Payload();
+    HistoryBlockHeader header{};
+    header.magic = HISTORY_BLOCK_MAGIC;
+    header.count = encoder_.Count();
+    header.first_time = encoder_.FirstTime();
+    header.last_time = encoder_.LastTime();
+    header.payload_bytes = static_cast<uint32_t>(payload.size());
+    header.checksum = HistoryChecksum(payload.data(), payload.size());
+
+    block_buffer_.resize(sizeof(header) + payload.size());
+    std::memcpy(block_buffer_.data(), &header, sizeof(header));
+    std::memcpy(block_buffer_.data() + sizeof(header), payload.data(),
+                payload.size());
+    encoder_.Reset();
+    if (!WriteAll(fd_, block_buffer_.data(), block_buffer_.size())) {
+      // 截掉写了一半的块, 否则后续块追加在损坏数据之后, 重新打开时
+      // 尾部恢复会从损坏处截断而丢弃它们; 索引与file_size_保持不变
+      std::cerr << "写入历史块失败: " << std::strerror(errno) << std::endl;
+      if (ftruncate(fd_, static_cast<off_t>(file_size_)) != 0)
+        std::cerr << "截断历史文件失败: " << std::strerror(errno) << std::endl;
+      return false;
+    }
+
+    HistoryIndexEntry entry{header.first_time, header.last_time, file_size_};
+    if (index_fd_ >= 0)
+      WriteAll(index_fd_, &entry, sizeof(entry));
+    file_size_ += block_buffer_.size();
+    blocks_written_++;
+    return true;
+  }
+
+  void Close() {
+    Flush();
+    if (fd_ >= 0)
+      close(fd_);
+    if (index_fd_ >= 0)
+      close(index_fd_);
+    fd_ = index_fd_ = -1;
+  }
+
+  uint64_t FileSize() const { return file_size_; }
+  uint64_t BlocksWritten() const { return blocks_written_; }
+  uint64_t SamplesWritten() const { return samples_written_; }
+};
+
+/// @brief 通过mmap读取历史文件
+class HistoryStoreReader {
+private:
+  const uint8_t *data_ = nullptr;
+  size_t size_ = 0;
+  std::vector<HistoryIndexEntry> index_;
+  bool time_ordered_ = true; // 各块时间是否递增(系统时间回拨后为false)
+
+  /// @brief 校验offset处的数据块
+  const HistoryBlockHeader *BlockAt(uint64_t offset) const {
+    if (offset + sizeof(HistoryBlockHeader) > size_)
+      return nullptr;
+    const auto *header =
+        reinterpret_cast<const HistoryBlockHeader *>(data_ + offset);
+    if (header->magic != HISTORY_BLOCK_MAGIC ||
+        offset + sizeof(HistoryBlockHeader) + header->payload_bytes > size_)
+      return nullptr;
+    return header;
+  }
+
+  /// @brief 读取索引文件, 不可用时扫描块头重建
+  void LoadIndex(const std::string &path) {
+    index_.clear();
+    int fd = open((path + ".idx").c_str(), O_RDONLY | O_CLOEXEC);
+    if (fd >= 0) {
+      struct stat st;
+      if (fstat(fd, &st) == 0 && st.st_size > 0) {
+        index_.resize(st.st_size / sizeof(HistoryIndexEntry));
+        if (pread(fd, index_.data(), index_.size() * sizeof(HistoryIndexEntry),
+                  0) < 0)
+          index_.clear();
+      }
+      close(fd);
+    }
+
+    // 索引须递增、每项指向有效块且覆盖到文件末尾, 否则重建
+    // (块之间允许有被跳过的损坏数据)
+    uint64_t expected = sizeof(HistoryFileHeader);
+    bool valid = true;
+    for (const HistoryIndexEntry &entry : index_) {
+      const HistoryBlockHeader *header = BlockAt(entry.offset);
+      if (entry.offset < expected || !header) {
+        valid = false;
+        break;
+      }
+      expected = entry.offset + sizeof(HistoryBlockHeader) +
+                 header->payload_bytes;
+    }
+    if (!valid || expected != size_)
+      RebuildIndex();
+
+    time_ordered_ = true;
+    for (size_t i = 1; i < index_.size(); i++) {
+      if (index_[i].first_time < index_[i - 1].last_time)
+        time_ordered_ = false;
+    }
+  }
+
+  /// @brief 扫描块头重建索引, 跳过校验失败的块
+  void RebuildIndex() { ScanHistoryBlocks(data_, size_, index_); }
+
+public:
+  HistoryStoreReader() = default;
+  HistoryStoreReader(const HistoryStoreReader &) = delete;
+  HistoryStoreReader &operator=(const HistoryStoreReader &) = delete;
+
+  ~HistoryStoreReader() { Close(); }
+
+  bool Open(const std::string &path) {
+    Close();
+    int fd = open(path.c_str(), O_RDONLY | O_CLOEXEC);
+    if (fd < 0) {
+      std::cerr << "无法打开历史文件: " << path << " (" << std::strerror(errno)
+                << ")" << std::endl;
+      return false;
+    }
+    struct stat st;
+    if (fstat(fd, &st) != 0 ||
+        static_cast<size_t>(st.st_size) < sizeof(HistoryFileHeader)) {
+      close(fd);
+      std::cerr << "历史文件格式错误: " << path << std::endl;
+      return false;
+    }
+    size_ = static_cast<size_t>(st.st_size);
+    void *mapped = mmap(nullptr, size_, PROT_READ, MAP_SHARED, fd, 0);
+    close(fd);
+    if (mapped == MAP_FAILED) {
+      size_ = 0;
+      std::cerr << "mmap失败: " << path << std::endl;
+      return false;
+    }
+    data_ = static_cast<const uint8_t *>(mapped);
+
+    const auto *header = reinterpret_cast<const HistoryFileHeader *>(data_);
+    if (header->magic != HISTORY_FILE_MAGIC ||
+        header->version != HISTORY_FORMAT_VERSION ||
+        header->channels != HISTORY_CHANNELS) {
+      std::cerr << "历史文件格式错误: " << path << std::endl;
+      Close();
+      return false;
+    }
+    LoadIndex(path);
+    return true;
+  }
+
+  void Close() {
+    if (data_)
+      munmap(const_cast<uint8_t *>(data_), size_);
+    data_ = nullptr;
+    size_ = 0;
+    index_.clear();
+    time_ordered_ = true;
+  }
+
+  /// @brief 读取[from_ms, to_ms]范围内的样本, 追加到out
+  /// @return 读取的样本数
+  size_t Query(int64_t from_ms, int64_t to_ms,
+               std::vector<MetricSample> &out) const {
+    const size_t before = out.size();
+    // 块按时间追加, 二分找到第一个可能包含from_ms的块;
+    // 时间不单调时逐块检查
+    auto it = index_.begin();
+    if (time_ordered_) {
+      it = std::lower_bound(index_.begin(), index_.end(), from_ms,
+                            [](const HistoryIndexEntry &entry, int64_t time) {
+                              return entry.last_time < time;
+                            });
+    }
+    for (; it != index_.end(); ++it) {
+      if (it->first_time > to_ms) {
+        if (time_ordered_)
+          break;
+        continue;
+      }
+      if (it->last_time < from_ms)
+        continue;
+      const HistoryBlockHeader *header = BlockAt(it->offset);
+      if (!header)
+        break;
+      DecodeHistoryBlock(*header,
+                         data_ + it->offset + sizeof(HistoryBlockHeader), out,
+                         from_ms, to_ms);
+    }
+    return out.size() - before;
+  }
+
+  const std::vector<HistoryIndexEntry> &Index() const { return index_; }
+  size_t FileSize() const { return size_; }
+
+  /// @brief 文件中的样本总数
+  uint64_t SampleCount() const {
+    uint64_t count = 0;
+    for (const HistoryIndexEntry &entry : index_)
+      count += BlockAt(entry.offset)->count;
+    return count;
+  }
+};
@@ -0,0 +1,137 @@
+#pragma once
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <cstring>
+#include <memory>
+
+/// @brief 紧凑的指标采样(40字节)
+struct MetricSample {
+  int64_t time_ms{0};    // 采样时间(Unix毫秒)
+  float cpu_usage{0};    // CPU使用率(%)
+  float mem_usage{0};    // 内存使用率(%)
+  float disk_usage{0};   // 磁盘使用率(%)
+  float cpu_temp{0};     // CPU温度(摄氏度)
+  float gpu_temp{0};     // GPU温度(摄氏度)
+  float rx_mbps{0};      // 接收速率(Mbps)
+  float tx_mbps{0};      // 发送速率(Mbps)
+  float load1{0};        // 1分钟负载
+};
+
+/// @brief 固定容量的指标历史环形缓冲区
+/// @note 单写者/多读者, 无锁无分配。每个槽位用序列号保护(seqlock),
+///       读者发现槽位正在被写或已被覆盖时丢弃该样本, 不会读到撕裂的数据
+class MetricHistory {
+private:
+  static constexpr size_t WORDS = sizeof(MetricSample) / sizeof(uint64_t);
+  static_assert(sizeof(MetricSample) % sizeof(uint64_t) == 0,
+                "MetricSample必须为8字节的整数倍");
+
+  /// @brief 槽位: seq为奇数表示写入中, 为2*(n+1)表示已写入第n个样本
+  struct Slot {
+    std::atomic<uint64_t> seq{0};
+    std::atomic<uint64_t> words[WORDS];
+  };
+
+  const size_t capacity_;
+  std::unique_ptr<Slot[]> slots_;
+  std::atomic<uint64_t> head_{0}; // 已写入的样本总数
+
+  /// @brief 读取第index个样本
+  /// @return 槽位已被覆盖或正在写入时返回false
+  bool ReadSlot(uint64_t index, MetricSample &sample) const {
+    const Slot &slot = slots_[index % capacity_];
+    const uint64_t expected = 2 * (index + 1);
+    if (slot.seq.load(std::memory_order_acquire) != expected)
+      return false;
+
+    uint64_t words[WORDS];
+    for (size_t i = 0; i < WORDS; i++)
+      words[i] = slot.words[i].load(std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_acquire);
+    if (slot.seq.load(std::memory_order_relaxed) != expected)
+      return false;
+
+    std::memcpy(&sample, words, sizeof(sample));
+    return true;
+  }
+
+public:
+  /// @param capacity 保留的样本数, 内存占用约为capacity * 48字节
+  explicit MetricHistory(size_t capacity)
+      : capacity_(capacity > 0 ? capacity : 1),
+        slots_(new Slot[capacity > 0 ? capacity : 1]) {
+    for (size_t i = 0; i < capacity_; i++) {
+      for (auto &word : slots_[i].words)
+        word.store(0, std::memory_order_relaxed);
+    }
+  }
+
+  MetricHistory(const MetricHistory &) = delete;
+  MetricHistory &operator=(const MetricHistory &) = delete;
+
+  /// @brief 追加一个样本(仅允许一个写者线程调用)
+  void Append(const MetricSample &sample) {
+    const uint64_t index = head_.load(std::memory_order_relaxed);
+    Slot &slot = slots_[index % capacity_];
+
+    uint64_t words[WORDS];
+    std::memcpy(words, &sample, sizeof(sample));
+
+    slot.seq.store(2 * index + 1, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+    for (size_t i = 0; i < WORDS; i++)
+      slot.words[i].store(words[i], std::memory_order_relaxed);
+    slot.seq.store(2 * (index + 1), std::memory_order_release);
+    head_.store(index + 1, std::memory_order_release);
+  }
+
+  /// @brief 读取最近的至多max个样本, 按时间从旧到新写入out
+  /// @return 实际读取的样本数
+  size_t ReadLatest(MetricSample *out, size_t max) const {
+    const uint64_t head = head_.load(std::memory_order_acquire);
+    const uint64_t available = std::min<uint64_t>({head, capacity_, max});
+    return ReadRange(head - available, head, out);
+  }
+
+  /// @brief 从游标处开始读取新样本, 供日志、导出等增量消费者使用
+  /// @param cursor 输入为上次读到的位置, 输出为下一次的起始位置;
+  ///               落后超过容量时跳过已被覆盖的样本
+  /// @return 实际读取的样本数
+  size_t ReadSince(uint64_t &cursor, MetricSample *out, size_t max) const {
+    const uint64_t head = head_.load(std::memory_order_acquire);
+    uint64_t begin = cursor;
+    if (head - begin > capacity_)
+      begin = head - capacity_;
+    const uint64_t end = std::min<uint64_t>(head, begin + max);
+    cursor = end;
+    return ReadRange(begin, end, out);
+  }
+
+  /// @brief 读取[begin, end)区间内仍然有效的样本
+  size_t ReadRange(uint64_t begin, uint64_t end, MetricSample *out) const {
+    size_t count = 0;
+    for (uint64_t index = begin; index < end; index++) {
+      if (ReadSlot(index, out[count]))
+        count++;
+    }
+    return count;
+  }
+
+  /// @brief 最新的一个样本
+  bool Latest(MetricSample &sample) const {
+    const uint64_t head = head_.load(std::memory_order_acquire);
+    return head > 0 && ReadSlot(head - 1, sample);
+  }
+
+  /// @brief 已写入的样本总数(单调递增, 可作为游标)
+  uint64_t Head() const { return head_.load(std::memory_order_acquire); }
+
+  size_t Capacity() const { return capacity_; }
+
+  /// @brief 当前保存的样本数
+  size_t Size() const { return std::min<uint64_t>(Head(), capacity_); }
+
+  /// @brief 缓冲区占用的内存(字节)
+  size_t MemoryBytes() const { return capacity_ * sizeof(Slot); }
+};
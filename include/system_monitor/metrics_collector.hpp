@@ -0,0 +1,200 @@
+#pragma once
+#include "metric_history.hpp"
+#include "system_monitor.hpp"
+#include <array>
+#include <chrono>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+/// @brief 可独立设定采样周期的指标
+enum class Metric : uint8_t {
+  TEMP,        // 温度传感器
+  CPU,         // CPU使用率
+  MEM,         // 内存
+  DISK,        // 磁盘
+  NET_INFO,    // 网卡地址
+  NET_TRAFFIC, // 网络流量
+  CPU_FREQ,    // CPU当前频率(上下限仅启动时读取)
+  LOAD,        // 系统负载
+  UPTIME,      // 运行时间
+  COUNT
+};
+
+/// @brief 指标采集配置, 周期单位为毫秒, 0表示仅启动时采集一次
+struct MetricsCollectorConfig {
+  uint32_t temp_ms = 1000;
+  uint32_t cpu_ms = 1000;
+  uint32_t mem_ms = 1000;
+  uint32_t disk_ms = 5000; // 读取后台统计缓存的周期
+  uint32_t net_info_ms = 10000;
+  uint32_t net_traffic_ms = 1000;
+  uint32_t cpu_freq_ms = 1000;
+  uint32_t load_ms = 5000;
+  uint32_t uptime_ms = 60000;
+  std::string disk_mount = "/"; // 使用率页面与历史记录使用的挂载点
+};
+
+/// @brief 一次采集得到的系统指标快照
+/// @note 慢指标未到期时保留上次的值
+struct MetricsSnapshot {
+  std::chrono::steady_clock::time_point time;      // 采集时间
+  std::chrono::system_clock::time_point wall_time; // 采集时的系统时间
+  uint64_t sequence{0};                            // 采集序号
+  uint32_t updated{0}; // 本次刷新的指标(按Metric取位)
+
+  DevTempInfo temp;
+  std::vector<double> sensor_temps; // 与SystemMonitor::Sensors()一一对应
+  CpuUsage cpu;
+  MemInfo mem;
+  DiskInfo disk{};                 // disk_mount对应的挂载点
+  std::vector<DiskInfo> disks;     // 所有块设备挂载点
+  std::vector<NetInfo> net_infos;
+  std::vector<NetTraffic> net_traffic;
+  SystemTime sys_time{};
+  CpuFreqInfo cpu_freq;
+  SystemLoad load;
+  std::string uptime;
+
+  /// @brief 指定指标是否在本次采集中刷新
+  bool Updated(Metric metric) const {
+    return updated & (1u << static_cast<uint8_t>(metric));
+  }
+};
+
+/// @brief 按各指标周期采集系统信息, 一次Collect()返回完整快照
+class MetricsCollector {
+public:
+  using Clock = std::chrono::steady_clock;
+
+private:
+  static constexpr size_t METRIC_COUNT = static_cast<size_t>(Metric::COUNT);
+
+  SystemMonitor &monitor_;
+  MetricsCollectorConfig config_;
+  MetricsSnapshot snapshot_;
+  std::array<uint32_t, METRIC_COUNT> period_ms_;
+  std::array<Clock::time_point, METRIC_COUNT> next_due_;
+
+  /// @brief 指标是否到期, 到期时安排下一次采集
+  bool Due(Metric metric, Clock::time_point now) {
+    const size_t index = static_cast<size_t>(metric);
+    if (now < next_due_[index])
+      return false;
+    next_due_[index] = period_ms_[index] > 0
+                           ? now + std::chrono::milliseconds(period_ms_[index])
+                           : Clock::time_point::max();
+    snapshot_.updated |= 1u << index;
+    return true;
+  }
+
+  /// @brief 读取单个指标到快照
+  void Fetch(Metric metric) {
+    switch (metric) {
+    case Metric::TEMP:
+      snapshot_.temp = monitor_.GetDevTempInfo();
+      monitor_.GetSensorTemps(snapshot_.sensor_temps);
+      break;
+    case Metric::CPU:
+      monitor_.GetCpuUsageDetail(snapshot_.cpu);
+      break;
+    case Metric::MEM:
+      snapshot_.mem = monitor_.GetMemInfo();
+      break;
+    case Metric::DISK:
+      monitor_.GetDisks(snapshot_.disks);
+      snapshot_.disk = DiskInfo{};
+      snapshot_.disk.mount_point = config_.disk_mount;
+      for (const DiskInfo &disk : snapshot_.disks) {
+        if (disk.mount_point == config_.disk_mount)
+          snapshot_.disk = disk;
+      }
+      break;
+    case Metric::NET_INFO:
+      snapshot_.net_infos = monitor_.GetNetInfo();
+      break;
+    case Metric::NET_TRAFFIC:
+      monitor_.GetNetTraffic(snapshot_.net_traffic);
+      break;
+    case Metric::CPU_FREQ:
+      snapshot_.cpu_freq.current_mhz = monitor_.GetCpuCurrentFreq();
+      break;
+    case Metric::LOAD:
+      snapshot_.load = monitor_.GetSystemLoad();
+      break;
+    case Metric::UPTIME:
+      snapshot_.uptime = monitor_.GetUptime();
+      break;
+    case Metric::COUNT:
+      break;
+    }
+  }
+
+public:
+  MetricsCollector(SystemMonitor &monitor,
+                   const MetricsCollectorConfig &config = {})
+      : monitor_(monitor), config_(config),
+        period_ms_{config.temp_ms,        config.cpu_ms,      config.mem_ms,
+                   config.disk_ms,        config.net_info_ms,
+                   config.net_traffic_ms, config.cpu_freq_ms, config.load_ms,
+                   config.uptime_ms} {
+    next_due_.fill(Clock::now());
+    snapshot_.cpu_freq = monitor_.GetCpuFreq(); // 频率上下限仅启动时读取
+  }
+
+  /// @brief 采集所有到期的指标
+  /// @return 最新快照, 未到期的指标为缓存值
+  const MetricsSnapshot &Collect(Clock::time_point now = Clock::now()) {
+    snapshot_.time = now;
+    snapshot_.wall_time = std::chrono::system_clock::now();
+    snapshot_.sequence++;
+    snapshot_.updated = 0;
+
+    for (size_t i = 0; i < METRIC_COUNT; i++) {
+      if (Due(static_cast<Metric>(i), now))
+        Fetch(static_cast<Metric>(i));
+    }
+    snapshot_.sys_time = monitor_.GetSystemTime(); // 开销很小, 每次都刷新
+    return snapshot_;
+  }
+
+  /// @brief 下一个指标到期的时间
+  Clock::time_point NextDue() const {
+    Clock::time_point next = Clock::time_point::max();
+    for (const Clock::time_point &due : next_due_)
+      next = std::min(next, due);
+    return next;
+  }
+
+  /// @brief 立即刷新单个指标(如网卡事件), 不改变其他指标与采样节奏
+  /// @return 最新快照, updated中仅包含该指标
+  const MetricsSnapshot &Refresh(Metric metric) {
+    snapshot_.updated = 1u << static_cast<size_t>(metric);
+    Fetch(metric);
+    return snapshot_;
+  }
+
+  const MetricsSnapshot &Snapshot() const { return snapshot_; }
+};
+
+/// @brief 由快照生成写入历史缓冲区的紧凑样本
+/// @note 流量为除回环接口外所有接口之和
+inline MetricSample ToMetricSample(const MetricsSnapshot &snapshot) {
+  MetricSample sample;
+  sample.time_ms = std::chrono::duration_cast<std::chrono::milliseconds>(
+                       snapshot.wall_time.time_since_epoch())
+                       .count();
+  sample.cpu_usage = static_cast<float>(snapshot.cpu.aggregate.total);
+  sample.mem_usage = static_cast<float>(snapshot.mem.usage_percent);
+  sample.disk_usage = static_cast<float>(snapshot.disk.usage_percent);
+  sample.cpu_temp = static_cast<float>(snapshot.temp.cpu_t);
+  sample.gpu_temp = static_cast<float>(snapshot.temp.gpu_t);
+  for (const NetTraffic &traffic : snapshot.net_traffic) {
+    if (traffic.interface_name == "lo")
+      continue;
+    sample.rx_mbps += static_cast<float>(traffic.rx_mbps);
+    sample.tx_mbps += static_cast<float>(traffic.tx_mbps);
+  }
+  sample.load1 = static_cast<float>(snapshot.load.load1);
+  return sample;
+}
@@ -0,0 +1,393 @@
+#pragma once
+#include "proc_reader.hpp"
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstring>
+#include <fnmatch.h>
+#include <linux/if_link.h>
+#include <linux/netlink.h>
+#include <linux/rtnetlink.h>
+#include <string>
+#include <string_view>
+#include <sys/socket.h>
+#include <unistd.h>
+#include <vector>
+
+/// @brief 网络流量信息
+struct NetTraffic {
+  std::string interface_name;
+  uint64_t rx_bytes{0};  // 接收字节数
+  uint64_t tx_bytes{0};  // 发送字节数
+  double rx_mbps{0};     // 接收速率(Mbps)
+  double tx_mbps{0};     // 发送速率(Mbps)
+};
+
+/// @brief 流量计数来源
+enum class TrafficBackend {
+  PROC_NET_DEV,    // 解析/proc/net/dev文本
+  NETLINK_STATS64, // RTM_GETLINK的IFLA_STATS64, 无文本解析
+};
+
+/// @brief 流量统计配置
+struct NetTrafficConfig {
+  TrafficBackend backend = TrafficBackend::PROC_NET_DEV;
+  std::vector<std::string> include; // 接口名通配(fnmatch), 为空表示全部
+  std::vector<std::string> exclude; // 排除的接口名通配, 优先于include
+  double ewma_alpha = 1.0; // 速率平滑系数(0,1], 1表示不平滑
+};
+
+/// @brief 按接口统计流量速率
+/// @note 接口名首次出现时分配小整数ID, 之后按ID访问平坦数组;
+///       稳态下每次采样不分配内存
+class NetTrafficEngine {
+private:
+  static constexpr uint32_t INVALID_ID = UINT32_MAX;
+
+  NetTrafficConfig config_;
+
+  // 按ID索引的平坦数组
+  std::vector<std::string> names_;
+  std::vector<uint64_t> prev_rx_, prev_tx_;   // 上次计数
+  std::vector<double> rate_rx_, rate_tx_;     // 速率(Mbps)
+  std::vector<uint64_t> seen_round_;          // 最近一次出现的采样轮次
+  std::vector<uint8_t> included_;             // 是否通过过滤
+  std::vector<uint8_t> has_prev_;             // 是否已有上次计数
+  std::vector<uint32_t> free_ids_;            // 已消失接口回收的ID
+
+  std::vector<uint32_t> sorted_ids_; // 按名称排序的活动ID, 用于二分查找
+  std::vector<uint32_t> line_ids_;   // 上次采样第i个接口的ID, 顺序不变时免查找
+  uint64_t round_ = 0;
+
+  std::chrono::steady_clock::time_point prev_time_;
+  ProcFile net_dev_file_{"/proc/net/dev", 16384};
+  int netlink_fd_ = -1;
+  uint32_t netlink_seq_ = 0;
+  std::vector<char> netlink_buffer_;
+
+  bool MatchAny(const std::vector<std::string> &patterns,
+                const std::string &name) const {
+    for (const std::string &pattern : patterns) {
+      if (fnmatch(pattern.c_str(), name.c_str(), 0) == 0)
+        return true;
+    }
+    return false;
+  }
+
+  bool Included(const std::string &name) const {
+    if (MatchAny(config_.exclude, name))
+      return false;
+    return config_.include.empty() || MatchAny(config_.include, name);
+  }
+
+  /// @brief 接口名转ID, 新接口分配ID(复用已回收的ID)
+  uint32_t Intern(std::string_view name, size_t line) {
+    // 接口顺序通常不变, 先检查上次同一位置的接口
+    if (line < line_ids_.size()) {
+      uint32_t id = line_ids_[line];
+      if (id != INVALID_ID && names_[id] == name)
+        return id;
+    }
+
+    auto it = std::lower_bound(
+        sorted_ids_.begin(), sorted_ids_.end(), name,
+        [this](uint32_t id, std::string_view key) { return names_[id] < key; });
+    uint32_t id;
+    if (it != sorted_ids_.end() && names_[*it] == name) {
+      id = *it;
+    } else {
+      if (!free_ids_.empty()) {
+        id = free_ids_.back();
+        free_ids_.pop_back();
+      } else {
+        id = static_cast<uint32_t>(names_.size());
+        names_.emplace_back();
+        prev_rx_.push_back(0);
+        prev_tx_.push_back(0);
+        rate_rx_.push_back(0);
+        rate_tx_.push_back(0);
+        seen_round_.push_back(0);
+        included_.push_back(0);
+        has_prev_.push_back(0);
+      }
+      names_[id].assign(name.data(), name.size());
+      rate_rx_[id] = rate_tx_[id] = 0;
+      has_prev_[id] = 0;
+      included_[id] = Included(names_[id]);
+      sorted_ids_.insert(it, id);
+    }
+
+    if (line >= line_ids_.size())
+      line_ids_.resize(line + 1, INVALID_ID);
+    line_ids_[line] = id;
+    return id;
+  }
+
+  /// @brief 接口链路速率(bit/s), 虚拟/无线接口或读取失败时返回0
+  static double LinkSpeedBps(const std::string &name) {
+    const std::string path = "/sys/class/net/" + name + "/speed";
+    ProcFile file(path.c_str(), 32);
+    std::string_view text = file.Read();
+    uint64_t mbps = 0; // 链路断开时为-1, 解析失败
+    if (!ProcScanner::NextU64(text, mbps))
+      return 0;
+    return static_cast<double>(mbps) * 1e6;
+  }
+
+  /// @brief 计数差值, 计数回退时区分32位计数器回绕与计数器复位
+  /// @param may_wrap 计数可能为32位(32位内核上/proc/net/dev的部分驱动计数)
+  /// @return 计数器复位(驱动重新加载、同名接口重建)时返回false, delta为0
+  /// @note 仅当回绕后的增量不超过链路速率在采样间隔内的上限时才按回绕处理,
+  ///       否则当作复位, 以新计数为基准
+  static bool CounterDelta(uint64_t prev, uint64_t curr, bool may_wrap,
+                           const std::string &name, double time_diff,
+                           uint64_t &delta) {
+    delta = 0;
+    if (curr >= prev) {
+      delta = curr - prev;
+      return true;
+    }
+    if (may_wrap && prev <= UINT32_MAX) {
+      const uint64_t wrapped = curr + (uint64_t(1) << 32) - prev;
+      if (wrapped * 8.0 <= LinkSpeedBps(name) * time_diff) {
+        delta = wrapped;
+        return true;
+      }
+    }
+    return false;
+  }
+
+  /// @brief 处理一个接口的计数
+  void Update(std::string_view name, size_t line, uint64_t rx_bytes,
+              uint64_t tx_bytes, bool may_wrap, double time_diff,
+              std::vector<NetTraffic> &traffic_list, size_t &count) {
+    const uint32_t id = Intern(name, line);
+    seen_round_[id] = round_;
+    if (!included_[id])
+      return;
+
+    if (has_prev_[id] && time_diff > 0) {
+      // 转换为 Mbps (1 byte = 8 bits, 1 Mbps = 1e6 bits/s)
+      const double scale = 8.0 / (time_diff * 1e6);
+      uint64_t rx_delta, tx_delta;
+      const bool rx_valid = CounterDelta(prev_rx_[id], rx_bytes, may_wrap,
+                                         names_[id], time_diff, rx_delta);
+      const bool tx_valid = CounterDelta(prev_tx_[id], tx_bytes, may_wrap,
+                                         names_[id], time_diff, tx_delta);
+      double rx = rx_delta * scale;
+      double tx = tx_delta * scale;
+      // 计数器复位的区间速率记0, 不与旧速率平滑
+      const double alpha = config_.ewma_alpha;
+      if (alpha > 0 && alpha < 1) {
+        if (rx_valid)
+          rx = alpha * rx + (1 - alpha) * rate_rx_[id];
+        if (tx_valid)
+          tx = alpha * tx + (1 - alpha) * rate_tx_[id];
+      }
+      rate_rx_[id] = rx;
+      rate_tx_[id] = tx;
+    }
+    prev_rx_[id] = rx_bytes;
+    prev_tx_[id] = tx_bytes;
+    has_prev_[id] = 1;
+
+    if (count == traffic_list.size())
+      traffic_list.emplace_back();
+    NetTraffic &traffic = traffic_list[count++];
+    traffic.interface_name = names_[id];
+    traffic.rx_bytes = rx_bytes;
+    traffic.tx_bytes = tx_bytes;
+    traffic.rx_mbps = rate_rx_[id];
+    traffic.tx_mbps = rate_tx_[id];
+  }
+
+  /// @brief 回收本轮未出现的接口ID
+  /// @note 清空名称并作废指向它的位置缓存, 否则同名接口在原位置重新出现时
+  ///       (如USB网卡重新插入)会命中已回收的ID并沿用旧计数
+  void ReclaimVanished() {
+    auto end = std::remove_if(sorted_ids_.begin(), sorted_ids_.end(),
+                              [this](uint32_t id) {
+                                if (seen_round_[id] == round_)
+                                  return false;
+                                names_[id].clear();
+                                free_ids_.push_back(id);
+                                return true;
+                              });
+    if (end == sorted_ids_.end())
+      return;
+    sorted_ids_.erase(end, sorted_ids_.end());
+    for (uint32_t &id : line_ids_) {
+      if (id != INVALID_ID && names_[id].empty())
+        id = INVALID_ID;
+    }
+  }
+
+  /// @brief 采样中途失败时, 本轮未读到的接口下次重新建立基准
+  /// @note 其上次计数早于prev_time_, 直接相减会得到偏大的速率
+  void ResetUnseen() {
+    for (uint32_t id : sorted_ids_) {
+      if (seen_round_[id] != round_)
+        has_prev_[id] = 0;
+    }
+  }
+
+  /// @brief 从/proc/net/dev读取
+  /// @note 32位内核上驱动的net_device_stats为unsigned long, 计数按32位回绕
+  void SampleProc(double time_diff, std::vector<NetTraffic> &traffic_list,
+                  size_t &count) {
+    constexpr bool MAY_WRAP = sizeof(unsigned long) < sizeof(uint64_t);
+    ProcScanner scanner(net_dev_file_.Read());
+    std::string_view line;
+    size_t index = 0;
+
+    // 跳过前两行
+    scanner.NextLine(line);
+    scanner.NextLine(line);
+
+    while (scanner.NextLine(line)) {
+      size_t colon = line.find(':');
+      if (colon == std::string_view::npos)
+        continue;
+      std::string_view iface_name = line.substr(0, colon);
+      ProcScanner::SkipSpaces(iface_name); // 去除前导空格
+      line.remove_prefix(colon + 1);
+
+      // 接收: bytes packets errs drop fifo frame compressed multicast
+      // 发送: bytes ...
+      uint64_t fields[9] = {};
+      bool parsed = true;
+      for (uint64_t &field : fields)
+        parsed = parsed && ProcScanner::NextU64(line, field);
+      if (!parsed)
+        continue;
+      Update(iface_name, index++, fields[0], fields[8], MAY_WRAP, time_diff,
+             traffic_list, count);
+    }
+  }
+
+  /// @brief 通过RTM_GETLINK读取IFLA_STATS64
+  /// @return 请求失败时返回false
+  bool SampleNetlink(double time_diff, std::vector<NetTraffic> &traffic_list,
+                     size_t &count) {
+    struct {
+      nlmsghdr nlh;
+      ifinfomsg ifi;
+    } request{};
+    request.nlh.nlmsg_len = NLMSG_LENGTH(sizeof(ifinfomsg));
+    request.nlh.nlmsg_type = RTM_GETLINK;
+    request.nlh.nlmsg_flags = NLM_F_REQUEST | NLM_F_DUMP;
+    request.nlh.nlmsg_seq = ++netlink_seq_;
+    request.ifi.ifi_family = AF_UNSPEC;
+    if (send(netlink_fd_, &request, request.nlh.nlmsg_len, 0) < 0)
+      return false;
+
+    size_t index = 0;
+    while (true) {
+      ssize_t n = recv(netlink_fd_, netlink_buffer_.data(),
+                       netlink_buffer_.size(), 0);
+      if (n <= 0)
+        return false;
+
+      int remaining = static_cast<int>(n);
+      for (auto *nlh = reinterpret_cast<const nlmsghdr *>(
+               netlink_buffer_.data());
+           NLMSG_OK(nlh, remaining); nlh = NLMSG_NEXT(nlh, remaining)) {
+        if (nlh->nlmsg_seq != netlink_seq_)
+          continue; // 上次中断请求的残留应答
+        if (nlh->nlmsg_type == NLMSG_DONE)
+          return true;
+        if (nlh->nlmsg_type == NLMSG_ERROR)
+          return false;
+        if (nlh->nlmsg_type != RTM_NEWLINK)
+          continue;
+
+        const auto *ifi = static_cast<const ifinfomsg *>(NLMSG_DATA(nlh));
+        std::string_view name;
+        // 属性仅保证4字节对齐, 拷贝出来再读取u64字段
+        rtnl_link_stats64 stats;
+        bool has_stats = false;
+        int len = IFLA_PAYLOAD(nlh);
+        for (const rtattr *rta = IFLA_RTA(ifi); RTA_OK(rta, len);
+             rta = RTA_NEXT(rta, len)) {
+          if (rta->rta_type == IFLA_IFNAME)
+            name = static_cast<const char *>(RTA_DATA(rta));
+          else if (rta->rta_type == IFLA_STATS64 &&
+                   RTA_PAYLOAD(rta) >= sizeof(rtnl_link_stats64)) {
+            std::memcpy(&stats, RTA_DATA(rta), sizeof(stats));
+            has_stats = true;
+          }
+        }
+        if (!name.empty() && has_stats)
+          Update(name, index++, stats.rx_bytes, stats.tx_bytes, false,
+                 time_diff, traffic_list, count);
+      }
+    }
+  }
+
+  void OpenNetlink() {
+    netlink_fd_ = socket(AF_NETLINK, SOCK_RAW | SOCK_CLOEXEC, NETLINK_ROUTE);
+    if (netlink_fd_ < 0)
+      return;
+    timeval timeout{1, 0}; // 避免应答丢失时阻塞采样线程
+    setsockopt(netlink_fd_, SOL_SOCKET, SO_RCVTIMEO, &timeout,
+               sizeof(timeout));
+    netlink_buffer_.resize(32768);
+  }
+
+  void CloseNetlink() {
+    if (netlink_fd_ >= 0)
+      close(netlink_fd_);
+    netlink_fd_ = -1;
+  }
+
+public:
+  explicit NetTrafficEngine(const NetTrafficConfig &config = {})
+      : prev_time_(std::chrono::steady_clock::now()) {
+    Configure(config);
+  }
+
+  NetTrafficEngine(const NetTrafficEngine &) = delete;
+  NetTrafficEngine &operator=(const NetTrafficEngine &) = delete;
+
+  ~NetTrafficEngine() { CloseNetlink(); }
+
+  /// @brief 更新配置, 已有接口按新规则重新过滤
+  void Configure(const NetTrafficConfig &config) {
+    config_ = config;
+    for (uint32_t id : sorted_ids_)
+      included_[id] = Included(names_[id]);
+
+    CloseNetlink();
+    if (config_.backend == TrafficBackend::NETLINK_STATS64)
+      OpenNetlink();
+  }
+
+  const NetTrafficConfig &Config() const { return config_; }
+
+  /// @brief 采样一次, 结果写入调用方复用的容器(仅包含通过过滤的接口)
+  void Sample(std::vector<NetTraffic> &traffic_list) {
+    auto current_time = std::chrono::steady_clock::now();
+    double time_diff =
+        std::chrono::duration<double>(current_time - prev_time_).count();
+    size_t count = 0;
+    round_++;
+
+    bool complete = false;
+    if (netlink_fd_ >= 0)
+      complete = SampleNetlink(time_diff, traffic_list, count);
+    if (!complete && count == 0) { // 未启用netlink或请求失败时退回文本解析
+      SampleProc(time_diff, traffic_list, count);
+      complete = true;
+    }
+    traffic_list.resize(count);
+    // netlink应答中途失败时未出现的接口不代表已消失, 不回收其ID
+    if (complete)
+      ReclaimVanished();
+    else
+      ResetUnseen();
+    prev_time_ = current_time;
+  }
+
+  /// @brief 已分配的接口ID数量(含已回收)
+  size_t InternedCount() const { return names_.size(); }
+};
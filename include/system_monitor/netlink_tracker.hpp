@@ -0,0 +1,393 @@
+#pragma once
+#include <algorithm>
+#include <arpa/inet.h>
+#include <atomic>
+#include <cerrno>
+#include <cstring>
+#include <functional>
+#include <iostream>
+#include <linux/netlink.h>
+#include <linux/rtnetlink.h>
+#include <mutex>
+#include <net/if.h>
+#include <poll.h>
+#include <string>
+#include <sys/eventfd.h>
+#include <sys/socket.h>
+#include <thread>
+#include <unistd.h>
+#include <vector>
+
+/// @brief 网络信息
+struct NetInfo {
+  std::string interface_name;
+  std::string ip;
+  std::string family;
+};
+
+/// @brief 网卡链路状态
+struct NetLink {
+  int index{0};        // 接口序号
+  std::string name;    // 接口名
+  bool up{false};      // 管理状态(IFF_UP)
+  bool running{false}; // 载波状态(IFF_RUNNING)
+};
+
+/// @brief 基于rtnetlink的网卡/地址跟踪器
+/// @note 启动时全量同步一次, 之后按内核通知增量更新, 读取只访问内存中的表
+class NetlinkTracker {
+public:
+  /// @brief 链路或地址变化时的回调(在后台线程中调用)
+  using Listener = std::function<void()>;
+
+private:
+  /// @brief 一条接口地址
+  struct Address {
+    int index{0};
+    int family{0};
+    uint8_t prefix_len{0};
+    std::string ip;
+  };
+
+  int fd_ = -1;                   // 订阅通知的套接字
+  std::vector<char> recv_buffer_; // 接收缓冲区
+  uint32_t dump_seq_ = 0;
+
+  mutable std::mutex mutex_; // 保护links_与addresses_
+  std::vector<NetLink> links_;
+  std::vector<Address> addresses_;
+  std::atomic<uint64_t> generation_{0}; // 每次表发生变化时递增
+
+  // 后台监听
+  std::thread worker_;
+  int wake_fd_ = -1;
+  std::atomic<bool> running_{false};
+  Listener listener_;
+
+  static int OpenSocket(uint32_t groups, int flags) {
+    int fd = socket(AF_NETLINK, SOCK_RAW | SOCK_CLOEXEC | flags, NETLINK_ROUTE);
+    if (fd < 0)
+      return -1;
+    sockaddr_nl addr{};
+    addr.nl_family = AF_NETLINK;
+    addr.nl_groups = groups;
+    if (bind(fd, reinterpret_cast<sockaddr *>(&addr), sizeof(addr)) < 0) {
+      close(fd);
+      return -1;
+    }
+    return fd;
+  }
+
+  NetLink *FindLink(int index) {
+    for (NetLink &link : links_) {
+      if (link.index == index)
+        return &link;
+    }
+    return nullptr;
+  }
+
+  /// @brief 处理RTM_NEWLINK/RTM_DELLINK, 调用方需持有mutex_
+  bool HandleLink(const nlmsghdr *nlh) {
+    const auto *ifi = static_cast<const ifinfomsg *>(NLMSG_DATA(nlh));
+    if (nlh->nlmsg_type == RTM_DELLINK) {
+      auto link_end = std::remove_if(
+          links_.begin(), links_.end(),
+          [ifi](const NetLink &link) { return link.index == ifi->ifi_index; });
+      auto addr_end = std::remove_if(
+          addresses_.begin(), addresses_.end(),
+          [ifi](const Address &addr) { return addr.index == ifi->ifi_index; });
+      bool changed = link_end != links_.end() || addr_end != addresses_.end();
+      links_.erase(link_end, links_.end());
+      addresses_.erase(addr_end, addresses_.end());
+      return changed;
+    }
+
+    NetLink updated;
+    updated.index = ifi->ifi_index;
+    updated.up = ifi->ifi_flags & IFF_UP;
+    updated.running = ifi->ifi_flags & IFF_RUNNING;
+    int len = IFLA_PAYLOAD(nlh);
+    for (const rtattr *rta = IFLA_RTA(ifi); RTA_OK(rta, len);
+         rta = RTA_NEXT(rta, len)) {
+      if (rta->rta_type == IFLA_IFNAME)
+        updated.name = static_cast<const char *>(RTA_DATA(rta));
+    }
+
+    NetLink *link = FindLink(updated.index);
+    if (!link) {
+      links_.push_back(std::move(updated));
+      return true;
+    }
+    if (updated.name.empty())
+      updated.name = link->name;
+    bool changed = link->name != updated.name || link->up != updated.up ||
+                   link->running != updated.running;
+    *link = std::move(updated);
+    return changed;
+  }
+
+  /// @brief 处理RTM_NEWADDR/RTM_DELADDR, 调用方需持有mutex_
+  bool HandleAddress(const nlmsghdr *nlh) {
+    const auto *ifa = static_cast<const ifaddrmsg *>(NLMSG_DATA(nlh));
+    if (ifa->ifa_family != AF_INET && ifa->ifa_family != AF_INET6)
+      return false;
+
+    // IPv4优先取IFA_LOCAL(点对点链路上IFA_ADDRESS为对端地址)
+    const void *address = nullptr;
+    const void *local = nullptr;
+    int len = IFA_PAYLOAD(nlh);
+    for (const rtattr *rta = IFA_RTA(ifa); RTA_OK(rta, len);
+         rta = RTA_NEXT(rta, len)) {
+      if (rta->rta_type == IFA_ADDRESS)
+        address = RTA_DATA(rta);
+      else if (rta->rta_type == IFA_LOCAL)
+        local = RTA_DATA(rta);
+    }
+    if (ifa->ifa_family == AF_INET && local)
+      address = local;
+    if (!address)
+      return false;
+
+    char host[INET6_ADDRSTRLEN];
+    if (!inet_ntop(ifa->ifa_family, address, host, sizeof(host)))
+      return false;
+
+    Address entry;
+    entry.index = static_cast<int>(ifa->ifa_index);
+    entry.family = ifa->ifa_family;
+    entry.prefix_len = ifa->ifa_prefixlen;
+    entry.ip = host;
+
+    auto it = std::find_if(addresses_.begin(), addresses_.end(),
+                           [&entry](const Address &addr) {
+                             return addr.index == entry.index &&
+                                    addr.family == entry.family &&
+                                    addr.ip == entry.ip;
+                           });
+    if (nlh->nlmsg_type == RTM_DELADDR) {
+      if (it == addresses_.end())
+        return false;
+      addresses_.erase(it);
+      return true;
+    }
+    if (it != addresses_.end()) {
+      bool changed = it->prefix_len != entry.prefix_len;
+      it->prefix_len = entry.prefix_len;
+      return changed;
+    }
+    addresses_.push_back(std::move(entry));
+    return true;
+  }
+
+  /// @brief 处理一批netlink消息
+  /// @return 表是否发生变化
+  bool HandleMessages(const char *data, size_t len, bool &done) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    bool changed = false;
+    int remaining = static_cast<int>(len);
+    for (auto *nlh = reinterpret_cast<const nlmsghdr *>(data);
+         NLMSG_OK(nlh, remaining); nlh = NLMSG_NEXT(nlh, remaining)) {
+      switch (nlh->nlmsg_type) {
+      case NLMSG_DONE:
+      case NLMSG_ERROR:
+        done = true;
+        break;
+      case RTM_NEWLINK:
+      case RTM_DELLINK:
+        changed |= HandleLink(nlh);
+        break;
+      case RTM_NEWADDR:
+      case RTM_DELADDR:
+        changed |= HandleAddress(nlh);
+        break;
+      default:
+        break;
+      }
+    }
+    return changed;
+  }
+
+  /// @brief 同步请求一次全量表(RTM_GETLINK或RTM_GETADDR)
+  bool Dump(uint16_t type) {
+    int fd = OpenSocket(0, 0);
+    if (fd < 0)
+      return false;
+
+    struct {
+      nlmsghdr nlh;
+      rtgenmsg gen;
+    } request{};
+    request.nlh.nlmsg_len = NLMSG_LENGTH(sizeof(rtgenmsg));
+    request.nlh.nlmsg_type = type;
+    request.nlh.nlmsg_flags = NLM_F_REQUEST | NLM_F_DUMP;
+    request.nlh.nlmsg_seq = ++dump_seq_;
+    request.gen.rtgen_family = AF_UNSPEC;
+
+    bool changed = false;
+    bool done = false;
+    if (send(fd, &request, request.nlh.nlmsg_len, 0) < 0) {
+      close(fd);
+      return false;
+    }
+    while (!done) {
+      ssize_t n = recv(fd, recv_buffer_.data(), recv_buffer_.size(), 0);
+      if (n <= 0)
+        break;
+      changed |= HandleMessages(recv_buffer_.data(), n, done);
+    }
+    close(fd);
+    return changed;
+  }
+
+  /// @brief 清空后全量重新同步(启动时或通知溢出后)
+  bool Resync() {
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      links_.clear();
+      addresses_.clear();
+    }
+    Dump(RTM_GETLINK);
+    Dump(RTM_GETADDR);
+    return true;
+  }
+
+  /// @brief 读取所有待处理的通知, 不阻塞
+  bool Drain() {
+    bool changed = false;
+    while (true) {
+      ssize_t n = recv(fd_, recv_buffer_.data(), recv_buffer_.size(),
+                       MSG_DONTWAIT);
+      if (n < 0) {
+        if (errno == ENOBUFS) { // 通知队列溢出, 丢失的事件只能靠全量同步补回
+          changed |= Resync();
+          continue;
+        }
+        break;
+      }
+      if (n == 0)
+        break;
+      bool done = false;
+      changed |= HandleMessages(recv_buffer_.data(), n, done);
+    }
+    if (changed)
+      generation_.fetch_add(1, std::memory_order_release);
+    return changed;
+  }
+
+  void ListenLoop() {
+    pollfd fds[2] = {{fd_, POLLIN, 0}, {wake_fd_, POLLIN, 0}};
+    while (running_.load()) {
+      if (poll(fds, 2, -1) < 0 && errno != EINTR)
+        break;
+      if (fds[1].revents & POLLIN)
+        break;
+      if ((fds[0].revents & POLLIN) && Drain() && listener_)
+        listener_();
+    }
+  }
+
+public:
+  NetlinkTracker() : recv_buffer_(32768) {
+    // 先订阅再全量同步, 避免错过两者之间发生的变化
+    fd_ = OpenSocket(RTMGRP_LINK | RTMGRP_IPV4_IFADDR | RTMGRP_IPV6_IFADDR,
+                     SOCK_NONBLOCK);
+    if (fd_ < 0) {
+      std::cerr << "netlink订阅失败: " << std::strerror(errno) << std::endl;
+      return;
+    }
+    Resync();
+    generation_.fetch_add(1, std::memory_order_release);
+  }
+
+  NetlinkTracker(const NetlinkTracker &) = delete;
+  NetlinkTracker &operator=(const NetlinkTracker &) = delete;
+
+  ~NetlinkTracker() {
+    Stop();
+    if (fd_ >= 0)
+      close(fd_);
+  }
+
+  bool IsOpen() const { return fd_ >= 0; }
+
+  /// @brief 通知套接字, 可加入调用方自己的poll/epoll
+  int Fd() const { return fd_; }
+
+  /// @brief 处理已到达的通知(未启动后台监听时使用)
+  /// @return 表是否发生变化
+  bool Poll() {
+    if (fd_ < 0 || running_.load())
+      return false;
+    return Drain();
+  }
+
+  /// @brief 启动后台监听, 通知到达后立即更新并调用listener
+  void Start(Listener listener = nullptr) {
+    if (fd_ < 0 || running_.load())
+      return;
+    wake_fd_ = eventfd(0, EFD_CLOEXEC);
+    if (wake_fd_ < 0)
+      return;
+    listener_ = std::move(listener);
+    running_ = true;
+    worker_ = std::thread(&NetlinkTracker::ListenLoop, this);
+  }
+
+  /// @brief 停止后台监听
+  void Stop() {
+    if (!running_.exchange(false))
+      return;
+    uint64_t one = 1;
+    if (write(wake_fd_, &one, sizeof(one)) < 0)
+      std::cerr << "netlink监听线程唤醒失败" << std::endl;
+    if (worker_.joinable())
+      worker_.join();
+    close(wake_fd_);
+    wake_fd_ = -1;
+  }
+
+  /// @brief 表的版本号, 每次链路或地址变化后递增
+  uint64_t Generation() const {
+    return generation_.load(std::memory_order_acquire);
+  }
+
+  /// @brief 当前所有地址(IPv4在前, 按接口序号排列)
+  void GetNetInfo(std::vector<NetInfo> &net_infos) const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    std::vector<const Address *> sorted;
+    sorted.reserve(addresses_.size());
+    for (const Address &addr : addresses_)
+      sorted.push_back(&addr);
+    std::stable_sort(sorted.begin(), sorted.end(),
+                     [](const Address *a, const Address *b) {
+                       if (a->family != b->family)
+                         return a->family == AF_INET;
+                       return a->index < b->index;
+                     });
+
+    net_infos.resize(sorted.size());
+    for (size_t i = 0; i < sorted.size(); i++) {
+      const Address &addr = *sorted[i];
+      const NetLink *link = nullptr;
+      for (const NetLink &l : links_) {
+        if (l.index == addr.index) {
+          link = &l;
+          break;
+        }
+      }
+      NetInfo &info = net_infos[i];
+      info.interface_name = link ? link->name : std::to_string(addr.index);
+      info.ip = addr.ip;
+      // 与getnameinfo一致, 链路本地IPv6地址附带作用域
+      if (addr.family == AF_INET6 && addr.ip.compare(0, 4, "fe80") == 0)
+        info.ip += "%" + info.interface_name;
+      info.family = addr.family == AF_INET ? "IPv4" : "IPv6";
+    }
+  }
+
+  /// @brief 当前所有链路状态
+  std::vector<NetLink> Links() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return links_;
+  }
+};
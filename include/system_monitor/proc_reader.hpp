@@ -0,0 +1,110 @@
+#pragma once
+#include <charconv>
+#include <cstdint>
+#include <fcntl.h>
+#include <string_view>
+#include <unistd.h>
+#include <vector>
+
+/// @brief 常驻文件描述符的/proc文件读取器
+/// @note 打开一次后每次用pread从偏移0重新读取到复用的缓冲区, 稳态下不分配内存
+class ProcFile {
+private:
+  int fd_ = -1;
+  std::vector<char> buffer_; // 读取缓冲区, 文件变大时扩容
+  size_t size_ = 0;          // 最近一次读取的有效字节数
+
+public:
+  /// @param path 文件路径
+  /// @param capacity 初始缓冲区大小(字节)
+  explicit ProcFile(const char *path, size_t capacity = 4096)
+      : fd_(open(path, O_RDONLY | O_CLOEXEC)), buffer_(capacity) {}
+
+  ProcFile(const ProcFile &) = delete;
+  ProcFile &operator=(const ProcFile &) = delete;
+
+  ~ProcFile() {
+    if (fd_ >= 0)
+      close(fd_);
+  }
+
+  bool IsOpen() const { return fd_ >= 0; }
+
+  /// @brief 文件描述符(如对mountinfo做poll)
+  int Fd() const { return fd_; }
+
+  /// @brief 重新读取整个文件
+  /// @return 文件内容, 失败时返回空
+  std::string_view Read() {
+    size_ = 0;
+    if (fd_ < 0)
+      return {};
+
+    while (true) {
+      ssize_t n = pread(fd_, buffer_.data() + size_, buffer_.size() - size_,
+                        static_cast<off_t>(size_));
+      if (n < 0)
+        return {};
+      if (n == 0)
+        break;
+      size_ += static_cast<size_t>(n);
+      if (size_ == buffer_.size()) // 缓冲区已满, 扩容后继续读取
+        buffer_.resize(buffer_.size() * 2);
+    }
+    return {buffer_.data(), size_};
+  }
+};
+
+/// @brief /proc文本扫描器, 按行、按字段解析且不复制数据
+class ProcScanner {
+private:
+  const char *pos_;
+  const char *end_;
+
+public:
+  explicit ProcScanner(std::string_view text)
+      : pos_(text.data()), end_(text.data() + text.size()) {}
+
+  /// @brief 取出下一行(不含换行符)
+  bool NextLine(std::string_view &line) {
+    if (pos_ >= end_)
+      return false;
+    const char *begin = pos_;
+    while (pos_ < end_ && *pos_ != '\n')
+      pos_++;
+    line = std::string_view(begin, pos_ - begin);
+    if (pos_ < end_)
+      pos_++;
+    return true;
+  }
+
+  /// @brief 在一行内跳过空白字符
+  static void SkipSpaces(std::string_view &text) {
+    size_t i = 0;
+    while (i < text.size() && (text[i] == ' ' || text[i] == '\t'))
+      i++;
+    text.remove_prefix(i);
+  }
+
+  /// @brief 取出下一个以空白分隔的字段
+  static std::string_view NextField(std::string_view &text) {
+    SkipSpaces(text);
+    size_t i = 0;
+    while (i < text.size() && text[i] != ' ' && text[i] != '\t')
+      i++;
+    std::string_view field = text.substr(0, i);
+    text.remove_prefix(i);
+    return field;
+  }
+
+  /// @brief 解析下一个无符号整数
+  /// @return 成功返回true, 失败时value不变
+  static bool NextU64(std::string_view &text, uint64_t &value) {
+    SkipSpaces(text);
+    auto result = std::from_chars(text.data(), text.data() + text.size(), value);
+    if (result.ec != std::errc())
+      return false;
+    text.remove_prefix(result.ptr - text.data());
+    return true;
+  }
+};
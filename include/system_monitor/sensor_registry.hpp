@@ -0,0 +1,228 @@
+#pragma once
+#include <algorithm>
+#include <cctype>
+#include <charconv>
+#include <cmath>
+#include <cstdint>
+#include <cstdlib>
+#include <dirent.h>
+#include <fcntl.h>
+#include <string>
+#include <string_view>
+#include <unistd.h>
+#include <vector>
+
+/// @brief 温度信息
+struct DevTempInfo {
+  double cpu_t{0}; // CPU温度(摄氏度)
+  double ddr_t{0}; // DDR温度(摄氏度)
+  double gpu_t{0}; // GPU温度(摄氏度)
+  double ve_t{0};  // VE温度(摄氏度)
+};
+
+/// @brief 传感器类别(由thermal zone的type或hwmon的name推断)
+enum class SensorKind { CPU, DDR, GPU, VE, OTHER };
+
+/// @brief 温度传感器注册表
+/// @note 启动时枚举thermal zone与hwmon一次, 常驻文件描述符, 之后用pread读取
+class SensorRegistry {
+public:
+  /// @brief 单个传感器
+  struct Sensor {
+    std::string name; // 传感器名称, 如"cpu"、"coretemp/Core 0"
+    std::string path; // 温度文件路径
+    SensorKind kind = SensorKind::OTHER;
+    int fd = -1;
+  };
+
+private:
+  std::vector<Sensor> sensors_;
+
+  /// @brief 读取一个短文本文件(去除末尾换行)
+  static std::string ReadText(const std::string &path) {
+    std::string text;
+    int fd = open(path.c_str(), O_RDONLY | O_CLOEXEC);
+    if (fd < 0)
+      return text;
+    char buf[128];
+    ssize_t n = read(fd, buf, sizeof(buf));
+    close(fd);
+    if (n > 0)
+      text.assign(buf, n);
+    while (!text.empty() && (text.back() == '\n' || text.back() == ' '))
+      text.pop_back();
+    return text;
+  }
+
+  /// @brief 列出目录下以prefix开头的条目, 按名称中的数字序号排序
+  static std::vector<std::string> ListEntries(const std::string &dir,
+                                              std::string_view prefix) {
+    std::vector<std::string> entries;
+    DIR *d = opendir(dir.c_str());
+    if (!d)
+      return entries;
+    while (dirent *entry = readdir(d)) {
+      std::string_view name(entry->d_name);
+      if (name.compare(0, prefix.size(), prefix) == 0)
+        entries.emplace_back(name);
+    }
+    closedir(d);
+
+    auto index = [&prefix](const std::string &name) {
+      return std::strtol(name.c_str() + prefix.size(), nullptr, 10);
+    };
+    std::sort(entries.begin(), entries.end(),
+              [&](const std::string &a, const std::string &b) {
+                return index(a) != index(b) ? index(a) < index(b) : a < b;
+              });
+    return entries;
+  }
+
+  /// @brief 去掉thermal zone类型名中的通用后缀, 如"cpu_thermal_zone" -> "cpu"
+  static std::string TrimThermalSuffix(std::string type) {
+    for (std::string_view suffix :
+         {"_thermal_zone", "-thermal-zone", "_thermal", "-thermal"}) {
+      if (type.size() > suffix.size() &&
+          type.compare(type.size() - suffix.size(), suffix.size(), suffix) ==
+              0) {
+        type.resize(type.size() - suffix.size());
+        break;
+      }
+    }
+    return type;
+  }
+
+  /// @brief 由名称推断传感器类别
+  static SensorKind ClassifyName(const std::string &name) {
+    std::string lower(name);
+    std::transform(lower.begin(), lower.end(), lower.begin(),
+                   [](unsigned char c) { return std::tolower(c); });
+    auto starts_with = [&lower](std::string_view prefix) {
+      return lower.compare(0, prefix.size(), prefix) == 0;
+    };
+    if (starts_with("cpu") || starts_with("soc") || starts_with("x86_pkg") ||
+        starts_with("coretemp") || starts_with("k10temp"))
+      return SensorKind::CPU;
+    if (starts_with("ddr") || starts_with("dram") || starts_with("mem"))
+      return SensorKind::DDR;
+    if (starts_with("gpu"))
+      return SensorKind::GPU;
+    if (starts_with("ve"))
+      return SensorKind::VE;
+    return SensorKind::OTHER;
+  }
+
+  void AddSensor(std::string name, std::string path) {
+    int fd = open(path.c_str(), O_RDONLY | O_CLOEXEC);
+    if (fd < 0)
+      return;
+    Sensor sensor;
+    sensor.kind = ClassifyName(name);
+    sensor.name = std::move(name);
+    sensor.path = std::move(path);
+    sensor.fd = fd;
+    sensors_.push_back(std::move(sensor));
+  }
+
+  /// @brief 枚举/sys/class/thermal/thermal_zone*
+  void DiscoverThermalZones(const std::string &root) {
+    for (const std::string &zone : ListEntries(root, "thermal_zone")) {
+      const std::string dir = root + "/" + zone;
+      std::string type = ReadText(dir + "/type");
+      AddSensor(type.empty() ? zone : TrimThermalSuffix(type), dir + "/temp");
+    }
+  }
+
+  /// @brief 枚举/sys/class/hwmon/hwmon*/temp*_input
+  void DiscoverHwmon(const std::string &root) {
+    for (const std::string &hwmon : ListEntries(root, "hwmon")) {
+      const std::string dir = root + "/" + hwmon;
+      std::string chip = ReadText(dir + "/name");
+      if (chip.empty())
+        chip = hwmon;
+
+      for (const std::string &entry : ListEntries(dir, "temp")) {
+        const std::string_view input_suffix = "_input";
+        if (entry.size() <= input_suffix.size() ||
+            entry.compare(entry.size() - input_suffix.size(),
+                          input_suffix.size(), input_suffix) != 0)
+          continue;
+
+        const std::string channel =
+            entry.substr(0, entry.size() - input_suffix.size());
+        std::string label = ReadText(dir + "/" + channel + "_label");
+        AddSensor(chip + "/" + (label.empty() ? channel : label),
+                  dir + "/" + entry);
+      }
+    }
+  }
+
+public:
+  /// @param thermal_root thermal zone目录
+  /// @param hwmon_root hwmon目录
+  explicit SensorRegistry(const std::string &thermal_root = "/sys/class/thermal",
+                          const std::string &hwmon_root = "/sys/class/hwmon") {
+    DiscoverThermalZones(thermal_root);
+    DiscoverHwmon(hwmon_root);
+  }
+
+  SensorRegistry(const SensorRegistry &) = delete;
+  SensorRegistry &operator=(const SensorRegistry &) = delete;
+
+  ~SensorRegistry() {
+    for (Sensor &sensor : sensors_) {
+      if (sensor.fd >= 0)
+        close(sensor.fd);
+    }
+  }
+
+  size_t Count() const { return sensors_.size(); }
+  const Sensor &At(size_t index) const { return sensors_[index]; }
+  const std::vector<Sensor> &Sensors() const { return sensors_; }
+
+  /// @brief 读取一个传感器
+  /// @return 温度(摄氏度), 读取失败时返回NaN
+  double Read(size_t index) const {
+    char buf[32];
+    ssize_t n = pread(sensors_[index].fd, buf, sizeof(buf), 0);
+    if (n <= 0)
+      return std::nan("");
+
+    const char *begin = buf;
+    while (begin < buf + n && *begin == ' ')
+      begin++;
+    long millidegree = 0;
+    if (std::from_chars(begin, buf + n, millidegree).ec != std::errc())
+      return std::nan("");
+    return millidegree / 1e3;
+  }
+
+  /// @brief 读取全部传感器, 结果与Sensors()一一对应
+  void ReadAll(std::vector<double> &celsius) const {
+    celsius.resize(sensors_.size());
+    for (size_t i = 0; i < sensors_.size(); i++)
+      celsius[i] = Read(i);
+  }
+
+  /// @brief 按类别读取第一个匹配的传感器
+  /// @return 温度(摄氏度), 没有该类传感器或读取失败时返回0
+  double ReadKind(SensorKind kind) const {
+    for (size_t i = 0; i < sensors_.size(); i++) {
+      if (sensors_[i].kind == kind) {
+        double value = Read(i);
+        return std::isnan(value) ? 0.0 : value;
+      }
+    }
+    return 0.0;
+  }
+
+  /// @brief 按类别映射为固定的四项温度信息
+  DevTempInfo ReadDevTempInfo() const {
+    DevTempInfo info;
+    info.cpu_t = ReadKind(SensorKind::CPU);
+    info.ddr_t = ReadKind(SensorKind::DDR);
+    info.gpu_t = ReadKind(SensorKind::GPU);
+    info.ve_t = ReadKind(SensorKind::VE);
+    return info;
+  }
+};
@@ -1,4 +1,10 @@
 #pragma once
+#include "cpu_sampler.hpp"
+#include "disk_monitor.hpp"
+#include "net_traffic_engine.hpp"
+#include "netlink_tracker.hpp"
+#include "proc_reader.hpp"
+#include "sensor_registry.hpp"
 #include <chrono>
 #include <cstdio>
 #include <fstream>
@@ -11,39 +17,12 @@
 #include <sys/sysinfo.h>
 #include <thread>
 #include <unordered_map>
+#include <vector>
 #include <ctime>
 #include <sys/socket.h>
 #include <netinet/in.h>
 #include <arpa/inet.h>
 
-/// @brief 温度信息
-struct DevTempInfo {
-  double cpu_t{0}; // CPU温度(摄氏度)
-  double ddr_t{0}; // DDR温度(摄氏度)
-  double gpu_t{0}; // GPU温度(摄氏度)
-  double ve_t{0};  // VE温度(摄氏度)
-};
-
-/// @brief cpu信息
-struct CpuTimeStamp {
-  uint64_t idle{0};  // idle + iowait
-  uint64_t total{0}; // 所有状态的总和
-  std::chrono::steady_clock::time_point time;
-};
-
-/// @brief 磁盘信息
-struct DiskInfo {
-  std::string mount_point;   // 挂载点路径
-  uint64_t block_size;       // 文件系统块大小(字节)
-  uint64_t total_blocks;     // 总块数
-  uint64_t free_blocks;      // 空闲块数
-  uint64_t available_blocks; // 可用块数(考虑保留空间)
-  uint64_t total_bytes;      // 总空间(字节)
-  uint64_t free_bytes;       // 空闲空间(字节)
-  uint64_t available_bytes;  // 可用空间(字节)
-  double usage_percent;      // 使用率百分比(0-100)
-};
-
 /// @brief CPU 核心统计信息
 struct CpuCoreStats {
   unsigned long idle{0};  // 空闲时间（包括 IO 等待）
@@ -57,22 +36,6 @@ struct MemInfo {
   double usage_percent{0}; // 使用率百分比(0-100)
 };
 
-/// @brief 网络信息
-struct NetInfo {
-  std::string interface_name;
-  std::string ip;
-  std::string family;
-};
-
-/// @brief 网络流量信息
-struct NetTraffic {
-  std::string interface_name;
-  uint64_t rx_bytes{0};  // 接收字节数
-  uint64_t tx_bytes{0};  // 发送字节数
-  double rx_mbps{0};     // 接收速率(Mbps)
-  double tx_mbps{0};     // 发送速率(Mbps)
-};
-
 /// @brief 系统时间信息
 struct SystemTime {
   int hour;
@@ -101,76 +64,58 @@ struct SystemLoad {
 class SystemMonitor {
 
 private:
-  std::ifstream file_reader_;
-  std::unordered_map<std::string, NetTraffic> prev_net_traffic_;
-  std::chrono::steady_clock::time_point prev_net_time_;
-
-private:
-  /// @brief 读取CPU状态
-  /// @return
-  std::vector<CpuTimeStamp> ReadCpuStats() {
-    std::ifstream file("/proc/stat");
-    std::vector<CpuTimeStamp> stamps;
-    std::string line;
-
-    while (std::getline(file, line) && line.compare(0, 3, "cpu") == 0) {
-      std::istringstream iss(line);
-      std::string label;
-      unsigned long user, nice, system, idle, iowait, irq, softirq, steal;
-      iss >> label >> user >> nice >> system >> idle >> iowait >> irq >>
-          softirq >> steal;
-
-      stamps.push_back({.idle = idle + iowait,
-                        .total = user + nice + system + idle + iowait + irq +
-                                 softirq + steal,
-                        .time = std::chrono::steady_clock::now()});
-    }
-    return stamps;
-  }
+  SensorRegistry sensors_; // 启动时枚举的温度传感器
+  CpuSampler cpu_sampler_;
+  CpuUsage cpu_usage_; // GetCpuUsage()复用的采样结果
+  ProcFile meminfo_file_{"/proc/meminfo"};
+  NetTrafficEngine net_traffic_;
+  NetlinkTracker net_tracker_; // 网卡地址表, 不可用时退回getifaddrs
+  DiskMonitor disk_monitor_;   // 块设备挂载点, statvfs在后台线程执行
+  ProcFile cpu_cur_freq_file_{
+      "/sys/devices/system/cpu/cpu0/cpufreq/scaling_cur_freq", 32};
 
 public:
-  /// @brief  获取CPU使用率
-  /// @return
+  /// @brief  获取CPU使用率(汇总), 不阻塞调用方
+  /// @return 与上次采样之间的平均使用率
   double GetCpuUsage() {
-    static std::vector<CpuTimeStamp> prev_stamps = ReadCpuStats();
-    std::this_thread::sleep_for(std::chrono::milliseconds(100)); // 采样间隔
-    auto curr_stamps = ReadCpuStats();
+    cpu_sampler_.Sample(cpu_usage_);
+    return cpu_usage_.aggregate.total;
+  }
 
-    if (prev_stamps.empty() || curr_stamps.size() != prev_stamps.size()) {
-      return 0.0;
-    }
+  /// @brief 获取CPU使用率(汇总与各核心, 含user/system/iowait/irq分项)
+  /// @note 后台采样运行时返回最近一次结果, 否则立即采样
+  CpuUsage GetCpuUsageDetail() { return cpu_sampler_.Sample(); }
 
-    double total_usage = 0.0;
-    for (size_t i = 0; i < curr_stamps.size(); ++i) {
-      unsigned long total_diff = curr_stamps[i].total - prev_stamps[i].total;
-      unsigned long idle_diff = curr_stamps[i].idle - prev_stamps[i].idle;
+  /// @brief 同GetCpuUsageDetail(), 结果写入调用方复用的对象
+  void GetCpuUsageDetail(CpuUsage &usage) { cpu_sampler_.Sample(usage); }
 
-      if (total_diff > 0) {
-        total_usage +=
-            (1.0 - static_cast<double>(idle_diff) / total_diff) * 100.0;
-      }
-    }
-    prev_stamps = curr_stamps;               // 更新状态
-    return total_usage / curr_stamps.size(); // 返回多核平均值
+  /// @brief 启动后台CPU采样
+  /// @param period 采样周期
+  void StartCpuSampler(std::chrono::milliseconds period) {
+    cpu_sampler_.Start(period);
   }
 
+  /// @brief 停止后台CPU采样
+  void StopCpuSampler() { cpu_sampler_.Stop(); }
+
   /// @brief 获取内存使用率
   /// @return
   /// @return
   MemInfo GetMemInfo() {
-    std::ifstream file("/proc/meminfo");
-    std::string line;
-    unsigned long total_kb = 0, free_kb = 0, buffers_kb = 0, cached_kb = 0;
-
-    while (file >> line) {
-      if (line == "MemTotal:")
-        file >> total_kb;
-      else if (line == "MemFree:")
-        file >> free_kb;
-      else if (line == "Buffers:")
-        file >> buffers_kb;
-      else if (line == "Cached:")
-        file >> cached_kb;
+    ProcScanner scanner(meminfo_file_.Read());
+    std::string_view line;
+    uint64_t total_kb = 0, free_kb = 0, buffers_kb = 0, cached_kb = 0;
+
+    while (scanner.NextLine(line)) {
+      std::string_view key = ProcScanner::NextField(line);
+      if (key == "MemTotal:")
+        ProcScanner::NextU64(line, total_kb);
+      else if (key == "MemFree:")
+        ProcScanner::NextU64(line, free_kb);
+      else if (key == "Buffers:")
+        ProcScanner::NextU64(line, buffers_kb);
+      else if (key == "Cached:")
+        ProcScanner::NextU64(line, cached_kb);
     }
 
     double total_mb = total_kb / 1024.0;
@@ -181,39 +126,17 @@ public:
     return {total_mb, used_mb, usage_percent};
   }
 
-  /// @brief 获取设备相关温度信息
+  /// @brief 获取设备相关温度信息(按传感器类别映射)
   /// @return
-  DevTempInfo GetDevTempInfo() {
-    std::string cpu_t_path = "/sys/class/thermal/thermal_zone0/temp",
-                ddr_t_path = "/sys/class/thermal/thermal_zone1/temp",
-                gpu_t_path = "/sys/class/thermal/thermal_zone2/temp",
-                ve_t_path = "/sys/class/thermal/thermal_zone3/temp";
-
-    DevTempInfo dev_temp_info;
-
-    file_reader_.open(cpu_t_path);
-    file_reader_ >> dev_temp_info.cpu_t;
-    file_reader_.close();
-
-    file_reader_.open(ddr_t_path);
-    file_reader_ >> dev_temp_info.ddr_t;
-    file_reader_.close();
-
-    file_reader_.open(gpu_t_path);
-    file_reader_ >> dev_temp_info.gpu_t;
-    file_reader_.close();
-
-    file_reader_.open(ve_t_path);
-    file_reader_ >> dev_temp_info.ve_t;
-    file_reader_.close();
+  DevTempInfo GetDevTempInfo() { return sensors_.ReadDevTempInfo(); }
 
-    dev_temp_info.cpu_t /= 1e3;
-    dev_temp_info.ddr_t /= 1e3;
-    dev_temp_info.gpu_t /= 1e3;
-    dev_temp_info.ve_t /= 1e3;
+  /// @brief 已发现的全部温度传感器
+  const SensorRegistry &Sensors() const { return sensors_; }
 
-    return dev_temp_info;
-  };
+  /// @brief 读取全部温度传感器(摄氏度, 读取失败为NaN), 与Sensors()一一对应
+  void GetSensorTemps(std::vector<double> &celsius) const {
+    sensors_.ReadAll(celsius);
+  }
 
   /// @brief 获取磁盘信息
   /// @param mount_point
@@ -226,36 +149,42 @@ public:
 
     DiskInfo info;
     info.mount_point = mount_point;
-    info.block_size = vfs.f_frsize;       // 文件系统块大小
-    info.total_blocks = vfs.f_blocks;     // 总块数
-    info.free_blocks = vfs.f_bfree;       // 空闲块数
-    info.available_blocks = vfs.f_bavail; // 可用块数
-
-    // 计算字节大小
-    info.total_bytes = info.total_blocks * info.block_size;
-    info.free_bytes = info.free_blocks * info.block_size;
-    info.available_bytes = info.available_blocks * info.block_size;
-
-    // 计算使用率百分比
-    if (info.total_bytes > 0) {
-      info.usage_percent =
-          100.0 *
-          (1.0 - static_cast<double>(info.available_bytes) / info.total_bytes);
-    } else {
-      info.usage_percent = 0.0;
-    }
-
+    FillDiskInfo(vfs, info);
     return info;
   };
 
+  /// @brief 获取所有块设备挂载点的磁盘信息(缓存结果, 不阻塞)
+  /// @note 统计由后台线程按周期执行, 超时的挂载点valid为false
+  void GetDisks(std::vector<DiskInfo> &disks) {
+    disk_monitor_.Refresh();
+    disk_monitor_.GetDisks(disks);
+  }
+
+  /// @brief 磁盘监控(配置挂载点过滤与统计周期)
+  DiskMonitor &Disks() { return disk_monitor_; }
+
+  /// @brief 获取网络信息
+  /// @note netlink可用时直接读取增量维护的地址表
   std::vector<NetInfo> GetNetInfo() {
     std::vector<NetInfo> net_infos;
+    GetNetInfo(net_infos);
+    return net_infos;
+  }
+
+  /// @brief 获取网络信息, 结果写入调用方复用的容器
+  void GetNetInfo(std::vector<NetInfo> &net_infos) {
+    if (net_tracker_.IsOpen()) {
+      net_tracker_.Poll();
+      net_tracker_.GetNetInfo(net_infos);
+      return;
+    }
+    net_infos.clear();
 
     // 获取网络信息
     struct ifaddrs *ifaddr, *ifa;
     if (getifaddrs(&ifaddr) == -1) {
       perror("getifaddrs");
-      return {};
+      return;
     }
 
     // 遍历网络信息
@@ -279,61 +208,32 @@ public:
       }
     }
     freeifaddrs(ifaddr);
-    return net_infos;
   }
 
+  /// @brief 获取网卡链路状态(up/running)
+  std::vector<NetLink> GetNetLinks() {
+    net_tracker_.Poll();
+    return net_tracker_.Links();
+  }
+
+  /// @brief 网卡地址跟踪器, 可启动后台监听以立即获得链路变化
+  NetlinkTracker &NetTracker() { return net_tracker_; }
+
   /// @brief 获取网络流量信息
   std::vector<NetTraffic> GetNetTraffic() {
     std::vector<NetTraffic> traffic_list;
-    std::ifstream file("/proc/net/dev");
-    std::string line;
-
-    // 跳过前两行
-    std::getline(file, line);
-    std::getline(file, line);
-
-    auto current_time = std::chrono::steady_clock::now();
-    double time_diff = std::chrono::duration_cast<std::chrono::milliseconds>(
-                          current_time - prev_net_time_)
-                          .count() / 1000.0;
-
-    while (std::getline(file, line)) {
-      std::istringstream iss(line);
-      std::string iface_name;
-      uint64_t rx_bytes, tx_bytes;
-      uint64_t dummy;
-
-      iface_name.resize(32);
-      if (sscanf(line.c_str(), "%32[^:]: %lu %*lu %*lu %*lu %*lu %*lu %*lu %*lu %lu %*lu %*lu %*lu %*lu %*lu",
-                 &iface_name[0], &rx_bytes, &tx_bytes) >= 2) {
-        // 去除空格
-        iface_name.erase(iface_name.find_last_not_of(" \t") + 1);
-
-        NetTraffic traffic;
-        traffic.interface_name = iface_name;
-        traffic.rx_bytes = rx_bytes;
-        traffic.tx_bytes = tx_bytes;
-
-        // 计算速率
-        if (time_diff > 0.1 && prev_net_traffic_.find(iface_name) != prev_net_traffic_.end()) {
-          auto& prev = prev_net_traffic_[iface_name];
-          double rx_diff = rx_bytes - prev.rx_bytes;
-          double tx_diff = tx_bytes - prev.tx_bytes;
-
-          // 转换为 Mbps (1 byte = 8 bits, 1 Mbps = 1e6 bits/s)
-          traffic.rx_mbps = (rx_diff * 8.0) / (time_diff * 1e6);
-          traffic.tx_mbps = (tx_diff * 8.0) / (time_diff * 1e6);
-        }
-
-        traffic_list.push_back(traffic);
-        prev_net_traffic_[iface_name] = traffic;
-      }
-    }
-
-    prev_net_time_ = current_time;
+    GetNetTraffic(traffic_list);
     return traffic_list;
   }
 
+  /// @brief 获取网络流量信息, 结果写入调用方复用的容器
+  void GetNetTraffic(std::vector<NetTraffic> &traffic_list) {
+    net_traffic_.Sample(traffic_list);
+  }
+
+  /// @brief 流量统计引擎, 用于配置接口过滤、平滑与计数来源
+  NetTrafficEngine &TrafficEngine() { return net_traffic_; }
+
   /// @brief 获取系统时间
   SystemTime GetSystemTime() {
     SystemTime st;
@@ -384,6 +284,14 @@ public:
     return freq;
   }
 
+  /// @brief 获取CPU当前频率(MHz), 不可用时返回0
+  double GetCpuCurrentFreq() {
+    std::string_view text = cpu_cur_freq_file_.Read();
+    uint64_t khz = 0;
+    ProcScanner::NextU64(text, khz);
+    return khz / 1000.0;
+  }
+
   /// @brief 获取系统负载
   SystemLoad GetSystemLoad() {
     SystemLoad load;
@@ -419,6 +327,6 @@ public:
   }
 
 public:
-  SystemMonitor() : prev_net_time_(std::chrono::steady_clock::now()) {};
+  SystemMonitor() {};
   ~SystemMonitor(){};
 };
@@ -1,5 +1,8 @@
 #include "../include/logkit/logkit.hpp"
 #include "../include/ssd1315_display/ui_manager.hpp"
+#include "../include/ssd1315_display/ui_scheduler.hpp"
+#include "../include/system_monitor/history_store.hpp"
+#include "../include/system_monitor/metrics_collector.hpp"
 #include "../include/system_monitor/system_monitor.hpp"
 #include <atomic>
 #include <iomanip>
@@ -11,10 +14,18 @@
 struct RuntimeConfig {
   bool enable_logging = true;
   bool enable_ui = true;
+  bool async_flush = true;
   uint32_t log_interval_sec = 1;
-  uint32_t ui_refresh_ms = 100;
-  uint32_t ui_cycles = 30;
-  uint32_t main_while_sec = 1;
+  uint32_t sample_interval_ms = 1000;
+  uint32_t history_capacity = 3600;
+  bool enable_history_file = true;
+  std::string history_path = "./data/metrics.hist";
+  MetricsCollectorConfig metrics;
+  NetTrafficConfig net_traffic;
+  DiskMonitorConfig disk;
+  uint32_t ui_max_fps = 10;
+  uint32_t ui_idle_fps = 5;
+  uint32_t ui_page_duration_ms = 1500;
 };
 
 int main(int argc, char const *argv[]) {
@@ -22,26 +33,39 @@ int main(int argc, char const *argv[]) {
   RuntimeConfig config;
   config.enable_logging = true; // 启用日志输出
   config.enable_ui = true;      // 启用UI更新
-  config.log_interval_sec = 2;  // 日志输出间隔(秒)
-  config.ui_refresh_ms = 100;   // UI刷新间隔(毫秒)
-  config.ui_cycles = 15;        // 每个页面的刷新次数（每个页面显示约1.5秒）
-  config.main_while_sec = 0;    // 主循环刷新间隔时间(毫秒)
+  config.async_flush = true;    // 异步刷新屏幕(渲染不等待总线传输)
+  config.log_interval_sec = 2;       // 日志输出间隔(秒)
+  config.sample_interval_ms = 1000;  // 系统信息采样间隔(毫秒)
+  config.history_capacity = 3600;    // 内存中保留的历史样本数(每个约48字节)
+  config.enable_history_file = true; // 历史数据写入文件(history-tool查看)
+  config.history_path = "./data/metrics.hist";
+  config.metrics.disk_ms = 5000;      // 读取磁盘统计缓存(同时检查挂载变化)
+  config.disk.stat_period_ms = 30000; // 磁盘用量变化缓慢
+  config.disk.stat_timeout_ms = 2000; // 超时的挂载点(如掉线的USB盘)暂停统计
+  config.metrics.net_info_ms = 10000; // 网卡地址很少变化
+  config.metrics.load_ms = 5000;      // 系统负载
+  config.metrics.uptime_ms = 60000;   // 运行时间精度为分钟
+  config.net_traffic.exclude = {"veth*", "docker*", "br-*"}; // 容器虚拟网卡
+  config.net_traffic.ewma_alpha = 1.0; // 流量速率平滑系数(1为不平滑)
+  config.ui_max_fps = 10;            // 数据变化时的最高刷新率
+  config.ui_idle_fps = 5;            // 动画页面的刷新率(低功耗时可调低)
+  config.ui_page_duration_ms = 1500; // 每个页面的显示时长(毫秒)
 
   LOGP_INFO("设备监控启动 (日志:%s 界面:%s)",
             config.enable_logging ? "开启" : "关闭",
             config.enable_ui ? "开启" : "关闭");
 
   try {
-    SystemMonitor system_monitor;
-
     // 尝试初始化OLED显示
-    std::unique_ptr<SSD1315Display> ssd1315_display;
+    std::unique_ptr<SSD1315Display128x64> ssd1315_display;
     std::unique_ptr<UiManager> ui_manager;
     bool oled_available = false;
 
     if (config.enable_ui) {
       try {
-        ssd1315_display = std::make_unique<SSD1315Display>("/dev/i2c-3");
+        ssd1315_display = std::make_unique<SSD1315Display128x64>("/dev/i2c-3");
+        if (config.async_flush)
+          ssd1315_display->StartAsyncFlush();
         ui_manager = std::make_unique<UiManager>(*ssd1315_display);
         oled_available = true;
 
@@ -59,151 +83,221 @@ int main(int argc, char const *argv[]) {
 
     std::atomic<uint32_t> cycle_count{0};
     auto last_log_time = std::chrono::steady_clock::now();
-    uint8_t current_page = 0;
-    const uint8_t total_pages = 6; // 总页数
+    const uint8_t total_pages = 9; // 总页数
+
+    UiSchedulerConfig scheduler_config;
+    scheduler_config.max_fps = config.ui_max_fps;
+    scheduler_config.idle_fps = config.ui_idle_fps;
+    scheduler_config.page_duration_ms = config.ui_page_duration_ms;
+    scheduler_config.page_count = total_pages;
+    UiScheduler ui_scheduler(scheduler_config);
+
+    // 在调度器之后构造, 保证网卡监听线程先于调度器停止
+    SystemMonitor system_monitor;
+    system_monitor.TrafficEngine().Configure(config.net_traffic);
+    system_monitor.Disks().Configure(config.disk);
+    MetricsCollector metrics_collector(system_monitor, config.metrics);
+    auto next_sample_time = std::chrono::steady_clock::now();
+    const MetricsSnapshot &metrics = metrics_collector.Snapshot();
+    MetricHistory metric_history(config.history_capacity);
+    HistoryStoreWriter history_writer;
+    if (config.enable_history_file &&
+        !history_writer.Open(config.history_path)) {
+      LOGP_WARN("历史文件不可用: %s, 仅保留内存历史",
+                config.history_path.c_str());
+    }
+
+    // 链路/地址变化时立即唤醒主循环, 不必等待下一个采样周期
+    NetlinkTracker &net_tracker = system_monitor.NetTracker();
+    uint64_t net_generation = net_tracker.Generation();
+    net_tracker.Start([&ui_scheduler] { ui_scheduler.Wake(); });
 
     while (true) {
-      cycle_count++;
       auto current_time = std::chrono::steady_clock::now();
 
-      // 获取系统信息
-      auto dev_temp_info = system_monitor.GetDevTempInfo();
-      double cpu_usage = system_monitor.GetCpuUsage();
-      auto dev_mem_info = system_monitor.GetMemInfo();
-      auto dev_disk_info = system_monitor.GetDiskInfo("/");
-      auto net_infos = system_monitor.GetNetInfo();
-      auto net_traffic = system_monitor.GetNetTraffic();
-      auto sys_time = system_monitor.GetSystemTime();
-      auto cpu_freq = system_monitor.GetCpuFreq();
-      auto sys_load = system_monitor.GetSystemLoad();
-      auto uptime = system_monitor.GetUptime();
-
-      // 条件日志输出
-      if (config.enable_logging &&
-          std::chrono::duration_cast<std::chrono::seconds>(current_time -
-                                                           last_log_time)
-                  .count() >= config.log_interval_sec) {
-
-        last_log_time = current_time;
-
-        std::stringstream status_log;
-        status_log << std::fixed << std::setprecision(1);
-
-        // 温度信息
-        status_log << "┌─[系统状态 #" << cycle_count << "]\n";
-        status_log << "├─[温度] CPU:" << std::setw(5) << dev_temp_info.cpu_t
-                   << "°C" << " DDR:" << std::setw(5) << dev_temp_info.ddr_t
-                   << "°C GPU:" << std::setw(5) << dev_temp_info.gpu_t
-                   << "°C\n";
-
-        // 资源使用率
-        status_log << "├─[使用率] CPU:" << std::setw(5) << cpu_usage << "%"
-                   << " 内存:" << std::setw(5) << dev_mem_info.usage_percent
-                   << "%" << " 磁盘:" << std::setw(5)
-                   << dev_disk_info.usage_percent << "%\n";
-
-        // CPU频率
-        status_log << "├─[CPU频率] " << std::setw(5) << cpu_freq.current_mhz
-                   << "MHz (" << cpu_freq.min_mhz << "-" << cpu_freq.max_mhz
-                   << ")\n";
-
-        // 系统负载
-        status_log << "├─[系统负载] 1m:" << std::setw(5) << sys_load.load1
-                   << " 5m:" << std::setw(5) << sys_load.load5
-                   << " 15m:" << std::setw(5) << sys_load.load15 << "\n";
-
-        // 运行时间
-        status_log << "├─[运行时间] " << uptime << "\n";
-
-        // 网络信息
-        status_log << "├─[网络接口]\n";
-        for (const auto &net : net_infos) {
-          status_log << "│  ├─" << net.interface_name << ": " << net.ip << " ("
-                     << net.family << ")\n";
-        }
+      // 只刷新网卡地址并重绘, 历史样本仍按采样周期追加
+      if (net_tracker.Generation() != net_generation) {
+        net_generation = net_tracker.Generation();
+        metrics_collector.Refresh(Metric::NET_INFO);
+        ui_scheduler.NotifyDataChanged();
+      }
 
-        // 网络流量
-        if (!net_traffic.empty()) {
-          status_log << "├─[网络流量] " << net_traffic[0].interface_name
-                     << "\n";
-          status_log << "│  ├─接收: " << std::fixed << std::setprecision(2)
-                     << net_traffic[0].rx_mbps << " Mbps\n";
-          status_log << "│  └─发送: " << std::fixed << std::setprecision(2)
-                     << net_traffic[0].tx_mbps << " Mbps\n";
-        }
+      // 到达采样周期时获取系统信息
+      if (current_time >= next_sample_time) {
+        cycle_count++;
+        next_sample_time =
+            current_time + std::chrono::milliseconds(config.sample_interval_ms);
 
-        // 系统时间
-        status_log << "└─[系统时间] " << std::setfill('0') << std::setw(2)
-                   << sys_time.hour << ":" << std::setw(2) << sys_time.minute
-                   << ":" << std::setw(2) << sys_time.second << "  "
-                   << sys_time.year << "/" << std::setw(2) << sys_time.month
-                   << "/" << std::setw(2) << sys_time.day << "\n";
+        metrics_collector.Collect();
+        const MetricSample sample = ToMetricSample(metrics);
+        metric_history.Append(sample);
+        history_writer.Append(sample);
+        next_sample_time =
+            std::min(next_sample_time, metrics_collector.NextDue());
+        ui_scheduler.NotifyDataChanged();
 
-        LOGP_INFO("%s", status_log.str().c_str());
-      }
+        // 条件日志输出
+        if (config.enable_logging &&
+            std::chrono::duration_cast<std::chrono::seconds>(current_time -
+                                                             last_log_time)
+                    .count() >= config.log_interval_sec) {
+          const DevTempInfo &dev_temp_info = metrics.temp;
+          const CpuUsage &cpu_usage_detail = metrics.cpu;
+          const MemInfo &dev_mem_info = metrics.mem;
+          const CpuFreqInfo &cpu_freq = metrics.cpu_freq;
+          const SystemLoad &sys_load = metrics.load;
+          const SystemTime &sys_time = metrics.sys_time;
 
-      // UI更新 - 循环显示多个页面
-      if (config.enable_ui && ui_manager) {
-        switch (current_page) {
-        case 0:
-          // 温度页面
-          for (uint32_t i = 0; i < config.ui_cycles; i++) {
-            ui_manager->DrawDevTempPage(dev_temp_info);
-            std::this_thread::sleep_for(
-                std::chrono::milliseconds(config.ui_refresh_ms));
-          }
-          break;
-        case 1:
-          // 资源使用率页面
-          for (uint32_t i = 0; i < config.ui_cycles; i++) {
-            ui_manager->DrawDevMemAndDiskAndCpuUsagePage(
-                cpu_usage, dev_mem_info, dev_disk_info);
-            std::this_thread::sleep_for(
-                std::chrono::milliseconds(config.ui_refresh_ms));
+          last_log_time = current_time;
+
+          std::stringstream status_log;
+          status_log << std::fixed << std::setprecision(1);
+
+          // 温度信息
+          status_log << "┌─[系统状态 #" << cycle_count << "]\n";
+          status_log << "├─[温度] CPU:" << std::setw(5) << dev_temp_info.cpu_t
+                     << "°C" << " DDR:" << std::setw(5) << dev_temp_info.ddr_t
+                     << "°C GPU:" << std::setw(5) << dev_temp_info.gpu_t
+                     << "°C\n";
+          for (size_t i = 0; i < metrics.sensor_temps.size(); i++) {
+            status_log << "│  ├─" << system_monitor.Sensors().At(i).name << ": "
+                       << std::setw(5) << metrics.sensor_temps[i] << "°C\n";
           }
-          break;
-        case 2:
-          // 网络信息页面
-          for (uint32_t i = 0; i < config.ui_cycles; i++) {
-            ui_manager->DrawNetInfosPage(net_infos);
-            std::this_thread::sleep_for(
-                std::chrono::milliseconds(config.ui_refresh_ms));
+
+          // 资源使用率
+          status_log << "├─[使用率] CPU:" << std::setw(5) << cpu_usage_detail.aggregate.total << "%"
+                     << " 内存:" << std::setw(5) << dev_mem_info.usage_percent
+                     << "%\n";
+
+          // 磁盘
+          status_log << "├─[磁盘]\n";
+          for (const DiskInfo &disk : metrics.disks) {
+            status_log << "│  ├─" << disk.mount_point << " (" << disk.device
+                       << " " << disk.fs_type << "): ";
+            if (disk.valid)
+              status_log << std::setw(5) << disk.usage_percent << "% "
+                         << disk.available_bytes / (1024 * 1024) << "MB可用\n";
+            else
+              status_log << "无法统计\n";
           }
-          break;
-        case 3:
-          // 网络流量页面
-          for (uint32_t i = 0; i < config.ui_cycles; i++) {
-            ui_manager->DrawNetTrafficPage(net_traffic);
-            std::this_thread::sleep_for(
-                std::chrono::milliseconds(config.ui_refresh_ms));
+
+          // CPU使用率分项
+          const CpuUtilization &cpu = cpu_usage_detail.aggregate;
+          status_log << "├─[CPU分项] usr:" << std::setw(5) << cpu.user
+                     << "% sys:" << std::setw(5) << cpu.system
+                     << "% io:" << std::setw(5) << cpu.iowait
+                     << "% irq:" << std::setw(5) << cpu.irq << "%\n";
+          for (size_t i = 0; i < cpu_usage_detail.cores.size(); i++) {
+            status_log << "│  ├─cpu" << i << ": " << std::setw(5)
+                       << cpu_usage_detail.cores[i].total << "%\n";
           }
-          break;
-        case 4:
-          // 系统时间页面
-          for (uint32_t i = 0; i < config.ui_cycles; i++) {
-            sys_time = system_monitor.GetSystemTime();
-            ui_manager->DrawSystemTimePage(sys_time);
-            std::this_thread::sleep_for(
-                std::chrono::milliseconds(config.ui_refresh_ms));
+
+          // CPU频率
+          status_log << "├─[CPU频率] " << std::setw(5) << cpu_freq.current_mhz
+                     << "MHz (" << cpu_freq.min_mhz << "-" << cpu_freq.max_mhz
+                     << ")\n";
+
+          // 系统负载
+          status_log << "├─[系统负载] 1m:" << std::setw(5) << sys_load.load1
+                     << " 5m:" << std::setw(5) << sys_load.load5
+                     << " 15m:" << std::setw(5) << sys_load.load15 << "\n";
+
+          // 运行时间
+          status_log << "├─[运行时间] " << metrics.uptime << "\n";
+
+          // 网络信息
+          status_log << "├─[网络接口]\n";
+          for (const auto &net : metrics.net_infos) {
+            status_log << "│  ├─" << net.interface_name << ": " << net.ip << " ("
+                       << net.family << ")\n";
           }
-          break;
-        case 5:
-          // 系统信息页面
-          for (uint32_t i = 0; i < config.ui_cycles; i++) {
-            ui_manager->DrawSystemInfoPage(cpu_freq, sys_load, uptime);
-            std::this_thread::sleep_for(
-                std::chrono::milliseconds(config.ui_refresh_ms));
+
+          // 网络流量
+          if (!metrics.net_traffic.empty()) {
+            status_log << "├─[网络流量] " << metrics.net_traffic[0].interface_name
+                       << "\n";
+            status_log << "│  ├─接收: " << std::fixed << std::setprecision(2)
+                       << metrics.net_traffic[0].rx_mbps << " Mbps\n";
+            status_log << "│  └─发送: " << std::fixed << std::setprecision(2)
+                       << metrics.net_traffic[0].tx_mbps << " Mbps\n";
           }
-          break;
-        }
 
-        // 切换到下一个页面
-        current_page = (current_page + 1) % total_pages;
+          // 日志写出(合并写入后的系统调用次数)
+          const LogKit::FlushStats log_stats =
+              LogKit::Instance().GetFlushStats();
+          uint64_t log_writes = 0;
+          for (uint64_t writes : log_stats.writes)
+            log_writes += writes;
+          status_log << "├─[日志写出] " << log_stats.lines << "条 write:"
+                     << log_writes << "次 fdatasync:" << log_stats.syncs
+                     << "次\n";
+
+          // 系统时间
+          status_log << "└─[系统时间] " << std::setfill('0') << std::setw(2)
+                     << sys_time.hour << ":" << std::setw(2) << sys_time.minute
+                     << ":" << std::setw(2) << sys_time.second << "  "
+                     << sys_time.year << "/" << std::setw(2) << sys_time.month
+                     << "/" << std::setw(2) << sys_time.day << "\n";
+
+          LOGP_INFO("%s", status_log.str().c_str());
+        }
       }
 
-      // 控制主循环速度
-      std::this_thread::sleep_for(
-          std::chrono::milliseconds(config.main_while_sec));
+      // UI更新 - 仅在数据变化、动画到期或翻页时重绘
+      if (config.enable_ui && ui_manager) {
+        // 先处理到期事件, 翻页后重绘与帧率选择都按新页面进行
+        const uint32_t reasons = ui_scheduler.Poll();
+        const uint8_t current_page = ui_scheduler.CurrentPage();
+        // 网络页图标与时间页秒针需要动画帧
+        ui_scheduler.SetAnimated(current_page == 2 || current_page == 4);
+
+        if (reasons != UiScheduler::NONE) {
+          switch (current_page) {
+          case 0:
+            // 温度页面
+            ui_manager->DrawDevTempPage(metrics.temp);
+            break;
+          case 1:
+            // 资源使用率页面
+            ui_manager->DrawDevMemAndDiskAndCpuUsagePage(
+                metrics.cpu.aggregate.total, metrics.mem, metrics.disk);
+            break;
+          case 2:
+            // 网络信息页面
+            ui_manager->DrawNetInfosPage(metrics.net_infos);
+            break;
+          case 3:
+            // 网络流量页面
+            ui_manager->DrawNetTrafficPage(metrics.net_traffic);
+            break;
+          case 4:
+            // 系统时间页面
+            ui_manager->DrawSystemTimePage(system_monitor.GetSystemTime());
+            break;
+          case 5:
+            // 系统信息页面
+            ui_manager->DrawSystemInfoPage(metrics.cpu_freq, metrics.load,
+                                           metrics.uptime);
+            break;
+          case 6:
+            // CPU与温度趋势页面
+            ui_manager->DrawCpuTempHistoryPage(metric_history);
+            break;
+          case 7:
+            // 网络速率趋势页面
+            ui_manager->DrawNetHistoryPage(metric_history);
+            break;
+          case 8:
+            // 磁盘页面(挂载点较多时每轮翻一页)
+            ui_manager->DrawDiskPage(metrics.disks);
+            break;
+          }
+        }
+        // 休眠到下一个UI事件或采样时间
+        ui_scheduler.SleepUntilNextEvent(next_sample_time);
+      } else {
+        std::this_thread::sleep_until(next_sample_time);
+      }
     }
   } catch (const std::exception &e) {
     LOGP_ERROR("系统错误: %s", e.what());
@@ -0,0 +1,121 @@
+// 历史文件查看/导出工具
+// 用法:
+//   history-tool info <文件>
+//   history-tool dump <文件> [--from 毫秒] [--to 毫秒]
+//   history-tool csv  <文件> [--from 毫秒] [--to 毫秒] [--output 输出.csv]
+// 时间参数为Unix毫秒时间戳, 缺省时为整个文件
+#include "../include/system_monitor/history_store.hpp"
+#include <cinttypes>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <ctime>
+#include <limits>
+
+namespace {
+
+void PrintUsage() {
+  std::fprintf(stderr,
+               "用法: history-tool <info|dump|csv> <文件> [--from 毫秒] "
+               "[--to 毫秒] [--output 文件]\n");
+}
+
+/// @brief 毫秒时间戳格式化为本地时间
+void FormatTime(int64_t time_ms, char *buf, size_t size) {
+  time_t seconds = static_cast<time_t>(time_ms / 1000);
+  struct tm tm;
+  localtime_r(&seconds, &tm);
+  size_t n = std::strftime(buf, size, "%Y-%m-%d %H:%M:%S", &tm);
+  std::snprintf(buf + n, size - n, ".%03d", static_cast<int>(time_ms % 1000));
+}
+
+void PrintInfo(const HistoryStoreReader &reader) {
+  const uint64_t samples = reader.SampleCount();
+  std::printf("文件大小: %zu 字节\n", reader.FileSize());
+  std::printf("数据块数: %zu\n", reader.Index().size());
+  std::printf("样本数:   %" PRIu64 "\n", samples);
+  if (samples > 0) {
+    char first[32], last[32];
+    FormatTime(reader.Index().front().first_time, first, sizeof(first));
+    FormatTime(reader.Index().back().last_time, last, sizeof(last));
+    std::printf("时间范围: %s ~ %s\n", first, last);
+    std::printf("平均每样本: %.2f 字节 (原始 %zu 字节)\n",
+                static_cast<double>(reader.FileSize()) / samples,
+                sizeof(MetricSample));
+  }
+}
+
+void PrintSamples(const std::vector<MetricSample> &samples, FILE *out,
+                  bool csv) {
+  if (csv)
+    std::fprintf(out, "time_ms,cpu_usage,mem_usage,disk_usage,cpu_temp,"
+                      "gpu_temp,rx_mbps,tx_mbps,load1\n");
+  for (const MetricSample &s : samples) {
+    if (csv) {
+      std::fprintf(out, "%" PRId64 ",%.2f,%.2f,%.2f,%.2f,%.2f,%.3f,%.3f,%.2f\n",
+                   s.time_ms, s.cpu_usage, s.mem_usage, s.disk_usage,
+                   s.cpu_temp, s.gpu_temp, s.rx_mbps, s.tx_mbps, s.load1);
+    } else {
+      char time[32];
+      FormatTime(s.time_ms, time, sizeof(time));
+      std::fprintf(out,
+                   "%s CPU:%5.1f%% MEM:%5.1f%% DISK:%5.1f%% T:%5.1f/%5.1fC "
+                   "RX:%7.3f TX:%7.3f LOAD:%.2f\n",
+                   time, s.cpu_usage, s.mem_usage, s.disk_usage, s.cpu_temp,
+                   s.gpu_temp, s.rx_mbps, s.tx_mbps, s.load1);
+    }
+  }
+}
+
+} // namespace
+
+int main(int argc, char const *argv[]) {
+  if (argc < 3) {
+    PrintUsage();
+    return 1;
+  }
+  const std::string command = argv[1];
+  const std::string path = argv[2];
+  int64_t from_ms = std::numeric_limits<int64_t>::min();
+  int64_t to_ms = std::numeric_limits<int64_t>::max();
+  const char *output = nullptr;
+
+  for (int i = 3; i < argc; i++) {
+    if (!std::strcmp(argv[i], "--from") && i + 1 < argc)
+      from_ms = std::strtoll(argv[++i], nullptr, 10);
+    else if (!std::strcmp(argv[i], "--to") && i + 1 < argc)
+      to_ms = std::strtoll(argv[++i], nullptr, 10);
+    else if (!std::strcmp(argv[i], "--output") && i + 1 < argc)
+      output = argv[++i];
+    else {
+      PrintUsage();
+      return 1;
+    }
+  }
+
+  HistoryStoreReader reader;
+  if (!reader.Open(path))
+    return 1;
+
+  if (command == "info") {
+    PrintInfo(reader);
+    return 0;
+  }
+  if (command != "dump" && command != "csv") {
+    PrintUsage();
+    return 1;
+  }
+
+  std::vector<MetricSample> samples;
+  reader.Query(from_ms, to_ms, samples);
+
+  FILE *out = stdout;
+  if (output && !(out = std::fopen(output, "w"))) {
+    std::perror(output);
+    return 1;
+  }
+  PrintSamples(samples, out, command == "csv");
+  if (out != stdout)
+    std::fclose(out);
+  return 0;
+}
@@ -0,0 +1,183 @@
+// 二进制日志(.blog)解码工具
+// 用法:
+//   logkit-decode <文件>... [--output 输出.log]
+// 按文本日志的格式输出: 时间(微秒) [级别] 函数名 L行号 正文
+#include "../include/logkit/log_binary.hpp"
+#include "../include/logkit/log_format.hpp"
+#include <cinttypes>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <iterator>
+#include <string>
+#include <vector>
+
+namespace {
+
+void PrintUsage() {
+  std::fprintf(stderr, "用法: logkit-decode <文件>... [--output 文件]\n");
+}
+
+struct Format {
+  bool valid = false;
+  uint8_t level = 0;
+  uint32_t line = 0;
+  std::string func;
+  std::string text;
+};
+
+/// @brief 顺序读取文件内容, 越界时置失败标志
+class Cursor {
+private:
+  const char *pos_;
+  const char *end_;
+  bool ok_ = true;
+
+public:
+  Cursor(const char *data, size_t size) : pos_(data), end_(data + size) {}
+
+  template <typename T> T Read() {
+    T value{};
+    if (end_ - pos_ < static_cast<ptrdiff_t>(sizeof(T))) {
+      ok_ = false;
+      pos_ = end_;
+      return value;
+    }
+    std::memcpy(&value, pos_, sizeof(T));
+    pos_ += sizeof(T);
+    return value;
+  }
+
+  const char *Bytes(size_t size) {
+    if (static_cast<size_t>(end_ - pos_) < size) {
+      ok_ = false;
+      pos_ = end_;
+      return nullptr;
+    }
+    const char *data = pos_;
+    pos_ += size;
+    return data;
+  }
+
+  std::string String() {
+    const uint16_t length = Read<uint16_t>();
+    const char *data = Bytes(length);
+    return data ? std::string(data, length) : std::string();
+  }
+
+  bool Ok() const { return ok_; }
+  bool End() const { return pos_ >= end_; }
+};
+
+const char *LevelToString(uint8_t level) {
+  static const char *levels[] = {"[MSG] ", "[INFO] ", "[WARN] ", "[DEBUG] ",
+                                 "[ERROR] "};
+  return level < 5 ? levels[level] : "[?] ";
+}
+
+/// @brief 解码一个文件
+/// @return 成功解码的记录数, 文件无效时返回-1
+long DecodeFile(const std::string &path, FILE *out) {
+  std::ifstream file(path, std::ios::binary);
+  if (!file.is_open()) {
+    std::perror(path.c_str());
+    return -1;
+  }
+  const std::string data((std::istreambuf_iterator<char>(file)),
+                         std::istreambuf_iterator<char>());
+  if (data.size() < sizeof(logbin::FILE_MAGIC) ||
+      std::memcmp(data.data(), logbin::FILE_MAGIC,
+                  sizeof(logbin::FILE_MAGIC)) != 0) {
+    std::fprintf(stderr, "%s: 不是二进制日志文件\n", path.c_str());
+    return -1;
+  }
+
+  Cursor cursor(data.data() + sizeof(logbin::FILE_MAGIC),
+                data.size() - sizeof(logbin::FILE_MAGIC));
+  std::vector<Format> formats;
+  TimestampCache time_cache;
+  std::string text;
+  long records = 0;
+
+  while (!cursor.End()) {
+    const uint8_t type = cursor.Read<uint8_t>();
+    if (type == logbin::FORMAT) {
+      const uint32_t id = cursor.Read<uint32_t>();
+      Format format;
+      format.level = cursor.Read<uint8_t>();
+      format.line = cursor.Read<uint32_t>();
+      format.func = cursor.String();
+      format.text = cursor.String();
+      format.valid = true;
+      if (!cursor.Ok())
+        break;
+      if (id >= formats.size())
+        formats.resize(id + 1);
+      formats[id] = std::move(format);
+    } else if (type == logbin::RECORD) {
+      const uint32_t id = cursor.Read<uint32_t>();
+      const int64_t time_ns = cursor.Read<int64_t>();
+      const uint16_t length = cursor.Read<uint16_t>();
+      const char *args = cursor.Bytes(length);
+      if (!cursor.Ok())
+        break;
+
+      text.clear();
+      if (id < formats.size() && formats[id].valid) {
+        const Format &format = formats[id];
+        logbin::RenderFormat(format.text.c_str(), args, length, text);
+        std::fprintf(out, "%.*s.%06d %s%s L%u %s\n", 19,
+                     time_cache.Format(time_ns).data(),
+                     static_cast<int>((time_ns / 1000) % 1000000),
+                     LevelToString(format.level), format.func.c_str(),
+                     format.line, text.c_str());
+      } else {
+        std::fprintf(out, "%.*s [?] <未知格式ID %u>\n", 19,
+                     time_cache.Format(time_ns).data(), id);
+      }
+      records++;
+    } else {
+      std::fprintf(stderr, "%s: 未知记录类型 0x%02x, 停止解码\n", path.c_str(),
+                   type);
+      return records;
+    }
+  }
+  // 进程异常退出时最后一条记录可能不完整
+  if (!cursor.Ok())
+    std::fprintf(stderr, "%s: 末尾记录不完整, 已忽略\n", path.c_str());
+  return records;
+}
+
+} // namespace
+
+int main(int argc, char const *argv[]) {
+  std::vector<std::string> paths;
+  const char *output = nullptr;
+  for (int i = 1; i < argc; i++) {
+    if (!std::strcmp(argv[i], "--output") && i + 1 < argc)
+      output = argv[++i];
+    else if (argv[i][0] == '-') {
+      PrintUsage();
+      return 1;
+    } else
+      paths.push_back(argv[i]);
+  }
+  if (paths.empty()) {
+    PrintUsage();
+    return 1;
+  }
+
+  FILE *out = stdout;
+  if (output && !(out = std::fopen(output, "w"))) {
+    std::perror(output);
+    return 1;
+  }
+  int status = 0;
+  for (const std::string &path : paths) {
+    if (DecodeFile(path, out) < 0)
+      status = 1;
+  }
+  if (out != stdout)
+    std::fclose(out);
+  return status;
+}